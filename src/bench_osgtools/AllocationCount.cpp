@@ -0,0 +1,56 @@
+/*
+	AllocationCount.cpp
+	Counts heap allocations by replacing the global operator new
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "AllocationCount.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<uint64_t> allocations(0);
+}
+
+void* operator new( std::size_t size )
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void* p = std::malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[]( std::size_t size )
+{
+	return operator new(size);
+}
+
+void operator delete( void* p ) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[]( void* p ) noexcept
+{
+	std::free(p);
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[]( void* p, std::size_t ) noexcept
+{
+	std::free(p);
+}
+
+uint64_t getAllocationCount()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,20 @@
+/*
+	AllocationCount.h
+	Counts heap allocations by replacing the global operator new
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <cstdint>
+
+/*!
+ *	Gets the number of calls to operator new since the process started.
+ *	The operator is replaced in the executable linking AllocationCount.cpp,
+ *	so allocations made inside the osgtools library are counted as well.
+ *	Shared by the benchmarks and the allocation tests.
+ */
+uint64_t getAllocationCount();
@@ -0,0 +1,34 @@
+/*
+	AllocationCounter.cpp
+	Counts heap allocations made by the benchmarked code
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "AllocationCounter.h"
+#include "AllocationCount.h"
+
+AllocationCounter::AllocationCounter() :
+	_start(getTotal())
+{}
+
+uint64_t AllocationCounter::getTotal()
+{
+	return getAllocationCount();
+}
+
+void AllocationCounter::reset()
+{
+	_start = getTotal();
+}
+
+uint64_t AllocationCounter::getCount() const
+{
+	return getTotal() - _start;
+}
+
+void AllocationCounter::report( benchmark::State& state ) const
+{
+	state.counters["allocs"] = benchmark::Counter((double)getCount(), benchmark::Counter::kAvgIterations);
+}
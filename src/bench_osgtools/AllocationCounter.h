@@ -0,0 +1,46 @@
+/*
+	AllocationCounter.h
+	Counts heap allocations made by the benchmarked code
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <cstdint>
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+/*!
+ *	Counts calls to the global operator new (see AllocationCount.h)
+ */
+class AllocationCounter {
+	uint64_t _start;
+
+public:
+	AllocationCounter();
+
+	/*!
+	 *	Gets the number of allocations since the process started
+	 */
+	static uint64_t getTotal();
+
+	/*!
+	 *	Starts counting at the current total
+	 */
+	void reset();
+
+	/*!
+	 *	Gets the number of allocations since the last reset
+	 */
+	uint64_t getCount() const;
+
+	/*!
+	 *	Reports the allocations per iteration as the "allocs" counter
+	 *	\param	state	The benchmark state, after the timing loop
+	 */
+	void report( benchmark::State& state ) const;
+};
@@ -0,0 +1,122 @@
+/*
+	PlotBenchmarks.cpp
+	Benchmarks of the plot build and update paths
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/ref_ptr>
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// Local
+#include "AllocationCounter.h"
+#include "histogram.h"
+
+namespace {
+
+	/*!
+	 *	Histogram exposing the label regeneration
+	 */
+	class BenchHistogram : public osgtools::Histogram {
+	public:
+		BenchHistogram() : osgtools::Histogram(800, 600) {}
+
+		void regenerateLabels() { resetAxisLabels(); }
+	};
+
+	/*!
+	 *	Creates bins with a repeating ramp
+	 */
+	std::vector<float> createBins( int numBins )
+	{
+		std::vector<float> bins(numBins);
+		for (int i=0; i < numBins; i++)
+			bins[i] = (float)(i % 100 + 1);
+		return bins;
+	}
+}
+
+static void BM_Histogram_SetHistogram( benchmark::State& state )
+{
+	osg::ref_ptr<BenchHistogram> pHistogram = new BenchHistogram();
+	std::vector<float> bins = createBins(state.range(0));
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pHistogram->setHistogram(bins);
+	}
+	allocations.report(state);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Histogram_SetHistogram)->RangeMultiplier(8)->Range(16, 1<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_Histogram_Redraw( benchmark::State& state )
+{
+	osg::ref_ptr<BenchHistogram> pHistogram = new BenchHistogram();
+	std::vector<float> bins = createBins(state.range(0));
+	pHistogram->setHistogram(bins);
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pHistogram->redraw();
+	}
+	allocations.report(state);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Histogram_Redraw)->RangeMultiplier(8)->Range(16, 1<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_Plot_SetRange( benchmark::State& state )
+{
+	osg::ref_ptr<BenchHistogram> pHistogram = new BenchHistogram();
+	std::vector<float> bins = createBins(state.range(0));
+	pHistogram->setHistogram(bins);
+
+	// Alternate between two ranges so every call changes the range
+	float ymax[2] = { 100.0, 200.0 };
+	int i = 0;
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pHistogram->setRange(-1, 0, state.range(0), ymax[i++ & 1]);
+	}
+	allocations.report(state);
+}
+BENCHMARK(BM_Plot_SetRange)->Arg(16)->Arg(1024)->Arg(1<<16)->Unit(benchmark::kMicrosecond);
+
+static void BM_Plot_RegenerateLabels( benchmark::State& state )
+{
+	osg::ref_ptr<BenchHistogram> pHistogram = new BenchHistogram();
+	std::vector<float> bins = createBins(1024);
+	pHistogram->setHistogram(bins);
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pHistogram->regenerateLabels();
+	}
+	allocations.report(state);
+}
+BENCHMARK(BM_Plot_RegenerateLabels)->Unit(benchmark::kMicrosecond);
+
+static void BM_Plot_Resize( benchmark::State& state )
+{
+	osg::ref_ptr<BenchHistogram> pHistogram = new BenchHistogram();
+	std::vector<float> bins = createBins(1024);
+	pHistogram->setHistogram(bins);
+
+	int width[2] = { 800, 1024 };
+	int i = 0;
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pHistogram->resize(width[i++ & 1], 600);
+	}
+	allocations.report(state);
+}
+BENCHMARK(BM_Plot_Resize)->Unit(benchmark::kMicrosecond);
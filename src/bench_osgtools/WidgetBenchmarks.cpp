@@ -0,0 +1,34 @@
+/*
+	WidgetBenchmarks.cpp
+	Benchmarks of the widget update paths
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+// OSG
+#include <osg/ref_ptr>
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// Local
+#include "AllocationCounter.h"
+#include "curtainwidget.h"
+
+static void BM_CurtainWidget_SetEndPoints( benchmark::State& state )
+{
+	const int width = 800;
+	osg::ref_ptr<osgtools::CurtainWidget> pCurtains = new osgtools::CurtainWidget(width, 600);
+
+	// Drag the left curtain across the widget
+	int left = 0;
+
+	AllocationCounter allocations;
+	for (auto _ : state) {
+		pCurtains->setEndPoints(left, width - 10);
+		left = (left + 1) % (width - 20);
+	}
+	allocations.report(state);
+}
+BENCHMARK(BM_CurtainWidget_SetEndPoints)->Unit(benchmark::kMicrosecond);
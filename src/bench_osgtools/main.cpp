@@ -0,0 +1,25 @@
+/*
+	main.cpp
+	Entry point for osgtools benchmark project
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <osg/Notify>
+
+int main( int argc, char* argv[] )
+{
+	// Keep font warnings out of the results
+	osg::setNotifyLevel(osg::FATAL);
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*
+	axisscale.cpp
+	Linear, logarithmic and custom scales of plot axes
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "axisscale.h"
+#include "ticks.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+double osgtools::AxisScale::getNiceStep( double range, int maxTicks ) const
+{
+	return Ticks::getNiceStep(range, maxTicks);
+}
+
+void osgtools::AxisScale::getTicks( double min, double max, double step, int maxTicks, std::vector<double>& values, bool bMinor ) const
+{
+	values.clear();
+	if (!isValid(min) || !isValid(max))
+		return;
+
+	// Place the ticks in scale space
+	TickSpan span;
+	if (!Ticks::getTicks(forward(min), forward(max), step, maxTicks, span))
+		return;
+	for (int i=0; i < span.count; i++)
+		values.push_back(inverse(span.getValue(i)));
+}
+
+void osgtools::AxisScale::formatLabel( double value, char* s, size_t size ) const
+{
+	snprintf(s, size, "%g", value);
+}
+
+void osgtools::AxisScale::getBinEdges( double min, double max, int numBins, std::vector<float>& edges ) const
+{
+	edges.clear();
+	if (numBins <= 0 || !isValid(min) || !isValid(max))
+		return;
+
+	double start = forward(min);
+	double width = (forward(max) - start) / numBins;
+	for (int i=0; i <= numBins; i++)
+		edges.push_back(inverse(start + i * width));
+}
+
+int osgtools::AxisScale::getBin( double value, double min, double max, int numBins ) const
+{
+	if (numBins <= 0 || !isValid(value) || !isValid(min) || !isValid(max))
+		return -1;
+
+	double start = forward(min);
+	double end = forward(max);
+	int bin = (int)floor((forward(value) - start) / (end - start) * numBins);
+	return (bin < 0 || bin >= numBins ? -1 : bin);
+}
+
+double osgtools::LogScale::forward( double value ) const
+{
+	// Clamp to the smallest positive value, so zero stays finite
+	return log10(std::max(value, DBL_MIN));
+}
+
+double osgtools::LogScale::inverse( double position ) const
+{
+	return pow(10.0, position);
+}
+
+double osgtools::LogScale::getNiceStep( double range, int maxTicks ) const
+{
+	// Whole decades
+	return std::max(Ticks::getNiceStep(range, maxTicks), 1.0);
+}
+
+void osgtools::LogScale::getTicks( double min, double max, double step, int maxTicks, std::vector<double>& values, bool bMinor ) const
+{
+	// A step of 0 turns the grid off
+	values.clear();
+	if (!(step > 0.0))
+		return;
+	if (!bMinor || step >= 1.0 || !isValid(min) || !isValid(max) || !(max > min)) {
+		AxisScale::getTicks(min, max, step, maxTicks, values);
+		return;
+	}
+
+	// Minor ticks at 1 to 9 times each power of ten, decades only if too many
+	double first = floor(forward(min));
+	double last = ceil(forward(max));
+	if ((last - first) * 9 > maxTicks) {
+		AxisScale::getTicks(min, max, 1.0, maxTicks, values);
+		return;
+	}
+	for (double decade = first; decade <= last; decade++) {
+		double power = inverse(decade);
+		for (int m=1; m <= 9; m++) {
+			double value = m * power;
+			if (value >= min && value < max)
+				values.push_back(value);
+		}
+	}
+}
+
+double osgtools::SymlogScale::forward( double value ) const
+{
+	double x = fabs(value) / _threshold;
+	double position = (x <= 1.0 ? x : 1.0 + log10(x));
+	return (value < 0 ? -position : position);
+}
+
+double osgtools::SymlogScale::inverse( double position ) const
+{
+	double t = fabs(position);
+	double x = (t <= 1.0 ? t : pow(10.0, t - 1.0)) * _threshold;
+	return (position < 0 ? -x : x);
+}
+
+double osgtools::SymlogScale::getNiceStep( double range, int maxTicks ) const
+{
+	// Whole steps land on the threshold times a power of ten
+	return std::max(Ticks::getNiceStep(range, maxTicks), 1.0);
+}
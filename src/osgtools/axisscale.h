@@ -0,0 +1,155 @@
+/*
+	axisscale.h
+	Linear, logarithmic and custom scales of plot axes
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <cstddef>
+#include <vector>
+
+// OSG
+#include <osg/Referenced>
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Maps the values of a plot axis to a scale space that is linear in
+	 *	pixels. Grid steps of an axis are given in scale space: data units
+	 *	on a linear axis, decades on a logarithmic one.
+	 */
+	class OSGTOOLS AxisScale : public osg::Referenced {
+	protected:
+		virtual ~AxisScale() {}
+
+	public:
+		/*!
+		 *	Maps a value to scale space
+		 */
+		virtual double forward( double value ) const = 0;
+
+		/*!
+		 *	Maps a position in scale space back to a value
+		 */
+		virtual double inverse( double position ) const = 0;
+
+		/*!
+		 *	Gets whether a value can be shown on the scale
+		 */
+		virtual bool isValid( double value ) const { return true; }
+
+		/*!
+		 *	Gets a nice grid step in scale space
+		 *	\param	range		The length of the range in scale space
+		 *	\param	maxTicks	The largest number of steps
+		 */
+		virtual double getNiceStep( double range, int maxTicks ) const;
+
+		/*!
+		 *	Places ticks in [min, max) at multiples of a step in scale space
+		 *	\param	min			The start of the range
+		 *	\param	max			The end of the range, excluded
+		 *	\param	step		The step in scale space
+		 *	\param	maxTicks	The largest number of ticks
+		 *	\param	values		The tick values, in increasing order, none
+		 *						for a step of 0
+		 *	\param	bMinor		True for the ticks of the minor grid
+		 */
+		virtual void getTicks( double min, double max, double step, int maxTicks, std::vector<double>& values, bool bMinor = false ) const;
+
+		/*!
+		 *	Formats the label of a tick
+		 *	\param	value	The tick value
+		 *	\param	s		The label
+		 *	\param	size	The size of the label buffer
+		 */
+		virtual void formatLabel( double value, char* s, size_t size ) const;
+
+		/*!
+		 *	Gets the edges of bins of equal width in scale space, as used by
+		 *	Histogram::setBinEdges
+		 *	\param	min			The start of the first bin
+		 *	\param	max			The end of the last bin
+		 *	\param	numBins		The number of bins
+		 *	\param	edges		numBins + 1 edges
+		 */
+		void getBinEdges( double min, double max, int numBins, std::vector<float>& edges ) const;
+
+		/*!
+		 *	Gets the bin of a value for bins from getBinEdges
+		 *	\return	The bin, or -1 if the value is outside of the bins
+		 */
+		int getBin( double value, double min, double max, int numBins ) const;
+	};
+
+	/*!
+	 *	Shows values as they are
+	 */
+	class OSGTOOLS LinearScale : public AxisScale {
+	public:
+		virtual double forward( double value ) const { return value; }
+		virtual double inverse( double position ) const { return position; }
+	};
+
+	/*!
+	 *	Shows positive values on a logarithmic axis. Nice major grid steps
+	 *	are whole decades; minor grid steps below a decade place ticks at 1
+	 *	to 9 times each power of ten.
+	 */
+	class OSGTOOLS LogScale : public AxisScale {
+	public:
+		virtual double forward( double value ) const;
+		virtual double inverse( double position ) const;
+		virtual bool isValid( double value ) const { return value > 0.0; }
+		virtual double getNiceStep( double range, int maxTicks ) const;
+		virtual void getTicks( double min, double max, double step, int maxTicks, std::vector<double>& values, bool bMinor = false ) const;
+	};
+
+	/*!
+	 *	Linear within [-threshold, threshold] and logarithmic outside of
+	 *	it, so ranges through zero can span many orders of magnitude.
+	 *	Whole steps in scale space fall on 0 and threshold times the
+	 *	powers of ten.
+	 */
+	class OSGTOOLS SymlogScale : public AxisScale {
+	protected:
+		double _threshold;
+
+	public:
+		SymlogScale( double threshold = 1.0 ) : _threshold(threshold > 0.0 ? threshold : 1.0) {}
+
+		virtual double forward( double value ) const;
+		virtual double inverse( double position ) const;
+		virtual double getNiceStep( double range, int maxTicks ) const;
+
+		double getThreshold() const { return _threshold; }
+	};
+
+	/*!
+	 *	Scale given by a pair of functions, such as sqrt and its square.
+	 *	The functions must be increasing.
+	 */
+	class OSGTOOLS FunctionScale : public AxisScale {
+	public:
+		typedef double (*Function)( double );
+
+	protected:
+		Function _forward;
+		Function _inverse;
+
+	public:
+		FunctionScale( Function forwardFunction, Function inverseFunction ) :
+			_forward(forwardFunction),
+			_inverse(inverseFunction)
+		{}
+
+		virtual double forward( double value ) const { return _forward(value); }
+		virtual double inverse( double position ) const { return _inverse(position); }
+	};
+}
@@ -0,0 +1,136 @@
+/*
+	boxplot.cpp
+	Box plot of many distributions for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "boxplot.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// Constants
+const float osgtools::BoxPlot::MEDIAN_WIDTH = 2.0;
+const float osgtools::BoxPlot::WHISKER_WIDTH = 1.0;
+
+osgtools::BoxPlot::BoxPlot( int width, int height ) :
+	DistributionPlot( width, height )
+{
+}
+
+void osgtools::BoxPlot::getValueRange( int i, float& min, float& max ) const
+{
+	min = _boxes[i].min;
+	max = _boxes[i].max;
+}
+
+bool osgtools::BoxPlot::setBoxes( const std::vector<BoxSummary>& boxes )
+{
+	// Handle bad input
+	if (boxes.empty())
+		return false;
+
+	_boxes = boxes;
+	updateDistributions();
+	return true;
+}
+
+bool osgtools::BoxPlot::setBox( int i, const BoxSummary& box )
+{
+	if (i < 0 || i >= _boxes.size())
+		return false;
+
+	_boxes[i] = box;
+	updateDistributions();
+	return true;
+}
+
+osgtools::BoxSummary osgtools::BoxPlot::getSummary( const QuantileSketch& sketch )
+{
+	return BoxSummary(sketch.getMin(), sketch.getQuantile(0.25), sketch.getQuantile(0.5),
+		sketch.getQuantile(0.75), sketch.getMax());
+}
+
+void osgtools::BoxPlot::computeBox( int i, const int* dim, float& left, float& right, float* y ) const
+{
+	left = getClampedPixel(0, i - HALF_WIDTH, dim);
+	right = getClampedPixel(0, i + HALF_WIDTH, dim);
+
+	const BoxSummary& box = _boxes[i];
+	y[0] = getClampedPixel(1, box.min, dim);
+	y[1] = getClampedPixel(1, box.q1, dim);
+	y[2] = getClampedPixel(1, box.median, dim);
+	y[3] = getClampedPixel(1, box.q3, dim);
+	y[4] = getClampedPixel(1, box.max, dim);
+}
+
+void osgtools::BoxPlot::redraw()
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "redraw");
+
+	if (!_pShapes.valid())
+		return;
+
+	// Box, median, whiskers and caps; lines outside of the range are flat
+	beginShapes();
+	for (int i=0; i < _boxes.size(); i++) {
+		float left, right, y[5];
+		computeBox(i, _layoutDim, left, right, y);
+		float center = (left + right) / 2, cap = (right - left) / 4;
+
+		addRect(left, y[1], right, y[3], _lightColor, _darkColor);
+		addLine(left, y[2], right, y[2], MEDIAN_WIDTH, _lineColor);
+		addLine(center, y[0], center, y[1], WHISKER_WIDTH, _lineColor);
+		addLine(center, y[3], center, y[4], WHISKER_WIDTH, _lineColor);
+		addLine(center - cap, y[0], center + cap, y[0], WHISKER_WIDTH, _lineColor);
+		addLine(center - cap, y[4], center + cap, y[4], WHISKER_WIDTH, _lineColor);
+	}
+	endShapes();
+}
+
+void osgtools::BoxPlot::drawVectorData( VectorCanvas& canvas )
+{
+	for (int i=0; i < _boxes.size(); i++) {
+		float left, right, y[5];
+		computeBox(i, _plotDim, left, right, y);
+		float center = (left + right) / 2, cap = (right - left) / 4;
+
+		canvas.rect(left, y[1], right, y[3], _lightColor, _darkColor);
+		canvas.line(left, y[2], right, y[2], MEDIAN_WIDTH, _lineColor);
+		canvas.line(center, y[0], center, y[1], WHISKER_WIDTH, _lineColor);
+		canvas.line(center, y[3], center, y[4], WHISKER_WIDTH, _lineColor);
+		canvas.line(center - cap, y[0], center + cap, y[0], WHISKER_WIDTH, _lineColor);
+		canvas.line(center - cap, y[4], center + cap, y[4], WHISKER_WIDTH, _lineColor);
+	}
+}
+
+bool osgtools::BoxPlot::pick( float x, float y, PlotPick& pick )
+{
+	if (x < _plotDim[0] || x > _plotDim[0] + _plotDim[2] || y < _plotDim[1] || y > _plotDim[1] + _plotDim[3])
+		return false;
+	int i = getDistribution(getXPixelValue(x));
+	if (i < 0)
+		return false;
+
+	pick.series = 0;
+	pick.index = i;
+	pick.row = -1;
+	pick.x = i;
+	pick.y = getYPixelValue(y);
+	pick.value = _boxes[i].median;
+	return true;
+}
+
+std::string osgtools::BoxPlot::getPickText( const PlotPick& pick )
+{
+	if (pick.index < 0 || pick.index >= _boxes.size())
+		return Plot::getPickText(pick);
+
+	const BoxSummary& box = _boxes[pick.index];
+	char s[128];
+	snprintf(s, sizeof(s), "%d: median %g, quartiles [%g, %g], range [%g, %g]",
+		pick.index, box.median, box.q1, box.q3, box.min, box.max);
+	return s;
+}
@@ -0,0 +1,102 @@
+/*
+	boxplot.h
+	Box plot of many distributions for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <vector>
+
+// Local
+#include "osgtools.h"
+#include "distributionplot.h"
+#include "quantilesketch.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Five number summary of a distribution
+	 */
+	struct BoxSummary {
+		float min;		/*!< End of the lower whisker */
+		float q1;		/*!< Bottom of the box */
+		float median;
+		float q3;		/*!< Top of the box */
+		float max;		/*!< End of the upper whisker */
+
+		BoxSummary() : min(0), q1(0), median(0), q3(0), max(0) {}
+		BoxSummary( float minValue, float q1Value, float medianValue, float q3Value, float maxValue ) :
+			min(minValue), q1(q1Value), median(medianValue), q3(q3Value), max(maxValue) {}
+	};
+
+	/*!
+	 *	Draws a box per distribution from its five number summary. Each box
+	 *	is six quads (box, median, whiskers and caps) in the batched
+	 *	geometry, whatever the size of the data it summarises.
+	 */
+	class OSGTOOLS BoxPlot : public DistributionPlot {
+	protected:
+		std::vector<BoxSummary> _boxes;
+
+		// Constants
+		static const float MEDIAN_WIDTH;
+		static const float WHISKER_WIDTH;
+
+		virtual void getValueRange( int i, float& min, float& max ) const;
+
+		/*!
+		 *	Computes the pixels of a box
+		 *	\param	i		The box
+		 *	\param	dim		The plot dimensions to map onto (_plotDim or _layoutDim)
+		 *	\param	left	The left of the box
+		 *	\param	right	The right of the box
+		 *	\param	y		The pixels of min, q1, median, q3 and max
+		 */
+		void computeBox( int i, const int* dim, float& left, float& right, float* y ) const;
+
+		/*!
+		 *	Draws the boxes of the vector output
+		 */
+		virtual void drawVectorData( VectorCanvas& canvas );
+
+	public:
+		BoxPlot( int width, int height );
+
+		/*!
+		 *	Sets the summaries, replacing all boxes
+		 *	\return	True if there are boxes
+		 */
+		bool setBoxes( const std::vector<BoxSummary>& boxes );
+
+		/*!
+		 *	Replaces the summary of a box
+		 *	\return	True if the box exists
+		 */
+		bool setBox( int i, const BoxSummary& box );
+
+		virtual int getNumDistributions() const { return _boxes.size(); }
+
+		/*!
+		 *	Gets the five number summary of a sketch
+		 */
+		static BoxSummary getSummary( const QuantileSketch& sketch );
+
+		/*!
+		 *	Redraws the boxes
+		 */
+		virtual void redraw();
+
+		/*!
+		 *	Finds the box at a pixel. The index is the box, the value its median.
+		 */
+		virtual bool pick( float x, float y, PlotPick& pick );
+
+		/*!
+		 *	Formats the summary of a pick
+		 */
+		virtual std::string getPickText( const PlotPick& pick );
+	};
+}
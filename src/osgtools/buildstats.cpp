@@ -0,0 +1,154 @@
+/*
+	buildstats.cpp
+	Per plot and widget build instrumentation
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "buildstats.h"
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/NodeVisitor>
+#include <osg/Stats>
+#include <osgText/TextBase>
+#include <osgViewer/View>
+#include <osgViewer/ViewerBase>
+#include <osgViewer/ViewerEventHandlers>
+
+namespace {
+
+	/*!
+	 *	Counts the drawables below a node
+	 */
+	class CountVisitor : public osg::NodeVisitor {
+	public:
+		osgtools::BuildStats& stats;
+
+		CountVisitor( osgtools::BuildStats& s ) :
+			osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN),
+			stats(s)
+		{}
+
+		virtual void apply( osg::Geode& geode ) {
+			for (unsigned int i=0; i < geode.getNumDrawables(); i++) {
+				osg::Drawable* pDrawable = geode.getDrawable(i);
+				if (dynamic_cast<osgText::TextBase*>(pDrawable)) {
+					stats.numTexts++;
+					stats.numDrawCalls++;
+					continue;
+				}
+
+				osg::Geometry* pGeometry = pDrawable->asGeometry();
+				if (!pGeometry)
+					continue;
+
+				stats.numDrawCalls += pGeometry->getNumPrimitiveSets();
+				if (pGeometry->getVertexArray()) {
+					stats.numVertices += pGeometry->getVertexArray()->getNumElements();
+					stats.numBytes += pGeometry->getVertexArray()->getTotalDataSize();
+				}
+				if (pGeometry->getColorArray())
+					stats.numBytes += pGeometry->getColorArray()->getTotalDataSize();
+				for (unsigned int j=0; j < pGeometry->getNumTexCoordArrays(); j++) {
+					if (pGeometry->getTexCoordArray(j))
+						stats.numBytes += pGeometry->getTexCoordArray(j)->getTotalDataSize();
+				}
+				for (unsigned int j=0; j < pGeometry->getNumPrimitiveSets(); j++) {
+					osg::DrawElements* pElements = pGeometry->getPrimitiveSet(j)->getDrawElements();
+					if (pElements)
+						stats.numBytes += pElements->getTotalDataSize();
+				}
+			}
+			traverse(geode);
+		}
+	};
+}
+
+void osgtools::BuildStats::countScene( osg::Node* pNode )
+{
+	numDrawCalls = numVertices = numTexts = numBytes = 0;
+	if (!pNode)
+		return;
+
+	CountVisitor visitor(*this);
+	pNode->accept(visitor);
+}
+
+osgtools::BuildScope::BuildScope( BuildStats& stats, osg::Node* pNode, const char* operation ) :
+	_stats(stats),
+	_pNode(pNode),
+	_operation(operation),
+	_start(osg::Timer::instance()->tick())
+{
+	_stats.depth++;
+}
+
+osgtools::BuildScope::~BuildScope()
+{
+	// Record the outermost operation only
+	if (--_stats.depth > 0)
+		return;
+
+	_stats.operation = _operation;
+	_stats.buildTime = osg::Timer::instance()->delta_s(_start, osg::Timer::instance()->tick());
+	_stats.totalBuildTime += _stats.buildTime;
+	_stats.numBuilds++;
+	_stats.countScene(_pNode);
+}
+
+void osgtools::BuildStatsHandler::addStats( const std::string& name, osg::Node* pNode, const BuildStats& stats )
+{
+	Entry entry;
+	entry.name = name;
+	entry.pStats = &stats;
+	entry.node = pNode;
+	entry.lastTotalBuildTime = stats.totalBuildTime;
+	_entries.push_back(entry);
+}
+
+void osgtools::BuildStatsHandler::addStatsLines( osgViewer::StatsHandler* pStatsHandler )
+{
+	if (!pStatsHandler)
+		return;
+
+	for (int i=0; i < _entries.size(); i++) {
+		pStatsHandler->addUserStatsLine(_entries[i].name,
+			osg::Vec4(0.7, 0.7, 1.0, 1.0), osg::Vec4(0.7, 0.7, 1.0, 0.5),
+			_entries[i].name + " build time", 1000.0, true, false,
+			"", "", 16.0);
+	}
+}
+
+bool osgtools::BuildStatsHandler::handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa )
+{
+	if (ea.getEventType() != osgGA::GUIEventAdapter::FRAME)
+		return false;
+
+	osgViewer::View* pView = dynamic_cast<osgViewer::View*>(&aa);
+	if (!pView || !pView->getViewerBase() || !pView->getFrameStamp())
+		return false;
+
+	osg::Stats* pStats = pView->getViewerBase()->getViewerStats();
+	if (!pStats)
+		return false;
+
+	unsigned int frame = pView->getFrameStamp()->getFrameNumber();
+	for (int i=0; i < _entries.size(); i++) {
+		// Skip plots and widgets that were deleted
+		osg::ref_ptr<osg::Node> pNode;
+		if (!_entries[i].node.lock(pNode))
+			continue;
+
+		// Time spent rebuilding since the previous frame
+		const BuildStats& stats = *_entries[i].pStats;
+		pStats->setAttribute(frame, _entries[i].name + " build time", stats.totalBuildTime - _entries[i].lastTotalBuildTime);
+		_entries[i].lastTotalBuildTime = stats.totalBuildTime;
+		pStats->setAttribute(frame, _entries[i].name + " draw calls", stats.numDrawCalls);
+		pStats->setAttribute(frame, _entries[i].name + " vertices", stats.numVertices);
+		pStats->setAttribute(frame, _entries[i].name + " texts", stats.numTexts);
+		pStats->setAttribute(frame, _entries[i].name + " bytes", stats.numBytes);
+	}
+	return false;
+}
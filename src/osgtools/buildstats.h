@@ -0,0 +1,126 @@
+/*
+	buildstats.h
+	Per plot and widget build instrumentation
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <string>
+#include <vector>
+
+// OSG
+#include <osg/Node>
+#include <osg/Timer>
+#include <osg/observer_ptr>
+#include <osgGA/GUIEventHandler>
+
+// Local
+#include "osgtools.h"
+
+namespace osgViewer {
+	class StatsHandler;
+}
+
+namespace osgtools {
+
+	/*!
+	 *	Statistics of the last rebuild of a plot or widget. Only recorded
+	 *	when the library is built with OSGTOOLS_ENABLE_STATS; otherwise the
+	 *	counters stay zero and no code runs.
+	 */
+	struct BuildStats {
+		const char* operation;		/*!< Name of the last rebuild ("redraw", "setRange", ...) */
+		double buildTime;			/*!< Duration of the last rebuild in seconds */
+		double totalBuildTime;		/*!< Duration of all rebuilds in seconds */
+		unsigned int numBuilds;		/*!< Number of rebuilds */
+		unsigned int numDrawCalls;	/*!< Draw calls of the scene after the last rebuild */
+		unsigned int numVertices;	/*!< Vertices of the scene after the last rebuild */
+		unsigned int numTexts;		/*!< Text drawables of the scene after the last rebuild */
+		unsigned int numBytes;		/*!< Vertex, color and index data of the scene after the last rebuild */
+		int depth;					/*!< Nesting of the open build scopes */
+
+		BuildStats() :
+			operation(""),
+			buildTime(0.0),
+			totalBuildTime(0.0),
+			numBuilds(0),
+			numDrawCalls(0),
+			numVertices(0),
+			numTexts(0),
+			numBytes(0),
+			depth(0)
+		{}
+
+		/*!
+		 *	Counts the draw calls, vertices, texts and bytes below a node
+		 */
+		void countScene( osg::Node* pNode );
+	};
+
+	/*!
+	 *	Times a rebuild and counts the resulting scene when it goes out of
+	 *	scope. Nested scopes (setRange calling redraw) are recorded once, as
+	 *	the outermost operation. Use OSGTOOLS_BUILD_SCOPE so the scope is
+	 *	compiled out when stats are disabled.
+	 */
+	class OSGTOOLS BuildScope {
+		BuildStats& _stats;
+		osg::Node* _pNode;
+		const char* _operation;
+		osg::Timer_t _start;
+
+	public:
+		BuildScope( BuildStats& stats, osg::Node* pNode, const char* operation );
+		~BuildScope();
+	};
+
+	/*!
+	 *	Publishes the build stats of plots and widgets to the viewer stats,
+	 *	so they show on the osgViewer StatsHandler overlay. Register the
+	 *	plots and widgets, call addStatsLines() before the stats handler is
+	 *	first shown, and add this handler to the view.
+	 */
+	class OSGTOOLS BuildStatsHandler : public osgGA::GUIEventHandler {
+	protected:
+		struct Entry {
+			std::string name;
+			const BuildStats* pStats;
+			osg::observer_ptr<osg::Node> node;
+			double lastTotalBuildTime;	/*!< Total build time at the previous frame */
+		};
+		std::vector<Entry> _entries;
+
+	public:
+		BuildStatsHandler() {}
+
+		/*!
+		 *	Adds the stats of a plot or widget
+		 *	\param	name	The name shown on the overlay
+		 *	\param	pNode	The plot or widget owning the stats
+		 *	\param	stats	The stats (getBuildStats())
+		 */
+		void addStats( const std::string& name, osg::Node* pNode, const BuildStats& stats );
+
+		/*!
+		 *	Adds a line per registered plot or widget to a stats handler,
+		 *	showing the time spent rebuilding it during each frame. The other
+		 *	counters are written as viewer stats attributes ("<name> vertices",
+		 *	"<name> draw calls", "<name> texts", "<name> bytes").
+		 */
+		void addStatsLines( osgViewer::StatsHandler* pStatsHandler );
+
+		/*!
+		 *	Writes the stats of the frame into the viewer stats
+		 */
+		virtual bool handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa );
+	};
+}
+
+#ifdef OSGTOOLS_ENABLE_STATS
+#define OSGTOOLS_BUILD_SCOPE(stats, node, operation) osgtools::BuildScope osgtoolsBuildScope(stats, node, operation)
+#else
+#define OSGTOOLS_BUILD_SCOPE(stats, node, operation)
+#endif
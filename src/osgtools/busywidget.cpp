@@ -37,5 +37,15 @@ osgtools::BusyWidget::BusyWidget( int width, int height, std::string& imagePath)
 	if (_backgroundImage.valid()) {
 		setWidth(_backgroundImage->s());
 		setHeight(_backgroundImage->t());
+		resize(width, height);
 	}
+}
+
+void osgtools::BusyWidget::resize( int windowWidth, int windowHeight )
+{
+	Widget::resize(windowWidth, windowHeight);
+
+	// Center the cursor
+	setX( (windowWidth - _width)/2 );
+	setY( (windowHeight - _height)/2 );
 }
\ No newline at end of file
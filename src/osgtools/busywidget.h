@@ -24,6 +24,13 @@ namespace osgtools {
 		BusyWidget() {}
 		BusyWidget( int width, int height );
 		BusyWidget( int width, int height, std::string& imagePath );
+
+		/*!
+		 *	Resizes the window and keeps the cursor centered
+		 *	\param	windowWidth		The width of the window in pixels
+		 *	\param	windowHeight	The height of the window in pixels
+		 */
+		virtual void resize( int windowWidth, int windowHeight );
 	};
 	
 }
\ No newline at end of file
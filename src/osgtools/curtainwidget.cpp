@@ -7,6 +7,7 @@
 */
 
 #include "curtainwidget.h"
+#include "shaders.h"
 
 osgtools::CurtainWidget::CurtainWidget() :
 	_left(-1),
@@ -65,7 +66,8 @@ osg::Geometry* osgtools::CurtainWidget::createCurtain( int x, int y, int width,
 	pColors->push_back(osg::Vec4(0.0, 0.0, 0.0, 0.85));
 	pGeo->setColorArray( pColors.get() );
 	pGeo->setColorBinding( osg::Geometry::BIND_OVERALL );
-	pGeo->addPrimitiveSet( new osg::DrawArrays(GL_QUADS, 0, 4) );
+	pGeo->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( pGeo.get() );
 
 	return pGeo.release();
 }
@@ -83,6 +85,7 @@ void osgtools::CurtainWidget::update()
 {
 	if (_left == -1 && _right == -1)
 		return;		
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "update");
 
 	if (!_leftCurtain.valid()) {
 		_leftCurtain = new osg::Geode();
@@ -110,6 +113,8 @@ void osgtools::CurtainWidget::update()
 		_rightCurtainSwitch->setAllChildrenOff();
 	else
 		_rightCurtainSwitch->setAllChildrenOn();
+
+	dirtyRedraw();
 }
 
 void osgtools::CurtainWidget::setOffset(int startX, int startY, int endX, int endY)
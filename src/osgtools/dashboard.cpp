@@ -0,0 +1,194 @@
+/*
+	dashboard.cpp
+	Tiles many plots in one camera pass
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "dashboard.h"
+#include "shaders.h"
+
+#include <algorithm>
+
+#include <osg/NodeVisitor>
+
+/*!
+ *	Rebuilds the shared chrome during the update traversal, after the
+ *	plots changed their layout
+ */
+class osgtools::Dashboard::ChromeCallback : public osg::NodeCallback {
+public:
+	virtual void operator()( osg::Node* pNode, osg::NodeVisitor* nv ) {
+		static_cast<Dashboard*>(pNode)->updateChrome();
+		traverse(pNode, nv);
+	}
+};
+
+osgtools::Dashboard::Dashboard( int width, int height, int numColumns ) :
+	_width(0),
+	_height(0),
+	_numColumns(std::max(numColumns, 1)),
+	_bChromeDirty(true)
+{
+	// Draw the chrome of all tiles under the plots
+	_pChromeGeode = new osg::Geode();
+	_pBackgrounds = createChromeGeometry(GL_TRIANGLES, _chrome.backgrounds.get(), _chrome.backgroundColors.get(), 0);
+	_pMinorLines = createChromeGeometry(GL_LINES, _chrome.minorLines.get(), _chrome.minorColors.get(), _chrome.minorWidth);
+	_pMajorLines = createChromeGeometry(GL_LINES, _chrome.majorLines.get(), _chrome.majorColors.get(), _chrome.majorWidth);
+	_pChromeGeode->addDrawable( _pBackgrounds.get() );
+	_pChromeGeode->addDrawable( _pMinorLines.get() );
+	_pChromeGeode->addDrawable( _pMajorLines.get() );
+	addChild( _pChromeGeode.get() );
+
+	setUpdateCallback( new ChromeCallback() );
+	resize( width, height );
+}
+
+osg::Geometry* osgtools::Dashboard::createChromeGeometry( GLenum mode, osg::Vec3Array* pVertices, osg::Vec4Array* pColors, float width )
+{
+	osg::ref_ptr<osg::Geometry> pGeometry = new osg::Geometry();
+	pGeometry->setDataVariance( osg::Object::DYNAMIC );
+	pGeometry->setVertexArray( pVertices );
+	pGeometry->setColorArray( pColors );
+	pGeometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+	pGeometry->addPrimitiveSet( new osg::DrawArrays(mode, 0, 0) );
+	if (width > 0)
+		Shaders::setLineWidth( pGeometry->getOrCreateStateSet(), width );
+	Shaders::setupGeometry( pGeometry.get() );
+
+	return pGeometry.release();
+}
+
+void osgtools::Dashboard::resize( int width, int height )
+{
+	if (width < 0 || height < 0)
+		return;
+
+	_width = width;
+	_height = height;
+
+	// Cover the window, clearing the depth once for all tiles
+	setProjectionMatrix(osg::Matrix::ortho2D(0,_width,0,_height));
+	setViewport(0,0,_width,_height);
+	setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+	setViewMatrix(osg::Matrix::identity());
+	setClearMask(GL_DEPTH_BUFFER_BIT);
+
+	getOrCreateStateSet()->setAttributeAndModes(Shaders::getColorProgram(), osg::StateAttribute::ON);
+	Shaders::setViewport(getOrCreateStateSet(), _width, _height);
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
+	getOrCreateStateSet()->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+#endif
+
+	layoutTiles();
+}
+
+void osgtools::Dashboard::setNumColumns( int numColumns )
+{
+	if (numColumns < 1 || numColumns == _numColumns)
+		return;
+
+	_numColumns = numColumns;
+	layoutTiles();
+}
+
+bool osgtools::Dashboard::addPlot( Plot* pPlot )
+{
+	if (!pPlot || std::find(_plots.begin(), _plots.end(), pPlot) != _plots.end())
+		return false;
+
+	_plots.push_back(pPlot);
+	_numLayouts.push_back(0);
+	addChild(pPlot);
+	layoutTiles();
+	return true;
+}
+
+bool osgtools::Dashboard::removePlot( Plot* pPlot )
+{
+	std::vector<osg::ref_ptr<Plot>>::iterator it = std::find(_plots.begin(), _plots.end(), pPlot);
+	if (it == _plots.end())
+		return false;
+
+	// Keep the plot alive until it is standalone again
+	osg::ref_ptr<Plot> pRemoved = pPlot;
+	_numLayouts.erase(_numLayouts.begin() + (it - _plots.begin()));
+	_plots.erase(it);
+	removeChild(pPlot);
+	pRemoved->clearTile();
+	layoutTiles();
+	return true;
+}
+
+bool osgtools::Dashboard::getTile( unsigned int index, int& x, int& y, int& width, int& height )
+{
+	if (index >= _plots.size())
+		return false;
+
+	// Fill rows from the top left
+	int numRows = (_plots.size() + _numColumns - 1) / _numColumns;
+	int column = index % _numColumns;
+	int row = index / _numColumns;
+	width = _width / _numColumns;
+	height = _height / numRows;
+	x = column * width;
+	y = _height - (row + 1) * height;
+	return true;
+}
+
+osgtools::Plot* osgtools::Dashboard::getPlotAt( float x, float y, float& plotX, float& plotY )
+{
+	int tile[4];
+	for (unsigned int i=0; i < _plots.size(); i++) {
+		getTile(i, tile[0], tile[1], tile[2], tile[3]);
+		if (x < tile[0] || x >= tile[0] + tile[2] || y < tile[1] || y >= tile[1] + tile[3])
+			continue;
+		plotX = x - tile[0];
+		plotY = y - tile[1];
+		return _plots[i].get();
+	}
+	return 0;
+}
+
+void osgtools::Dashboard::layoutTiles()
+{
+	int tile[4];
+	for (unsigned int i=0; i < _plots.size(); i++) {
+		getTile(i, tile[0], tile[1], tile[2], tile[3]);
+		_plots[i]->setTile(tile[0], tile[1], tile[2], tile[3]);
+	}
+	_bChromeDirty = true;
+}
+
+void osgtools::Dashboard::updateChrome()
+{
+	// Rebuild only when a tile moved or changed its layout
+	for (unsigned int i=0; i < _plots.size() && !_bChromeDirty; i++)
+		_bChromeDirty = (_plots[i]->getNumLayouts() != _numLayouts[i]);
+	if (!_bChromeDirty)
+		return;
+	_bChromeDirty = false;
+
+	// Refill the shared arrays in place, keeping their storage
+	_chrome.clear();
+	int tile[4];
+	for (unsigned int i=0; i < _plots.size(); i++) {
+		getTile(i, tile[0], tile[1], tile[2], tile[3]);
+		_plots[i]->appendChrome(tile[0], tile[1], _chrome);
+		_numLayouts[i] = _plots[i]->getNumLayouts();
+	}
+	_pMinorLines->getStateSet()->getUniform("osgtools_LineWidth")->set(_chrome.minorWidth);
+	_pMajorLines->getStateSet()->getUniform("osgtools_LineWidth")->set(_chrome.majorWidth);
+
+	osg::Geometry* geometries[3] = { _pBackgrounds.get(), _pMinorLines.get(), _pMajorLines.get() };
+	for (int i=0; i < 3; i++) {
+		osg::DrawArrays* pDrawArrays = static_cast<osg::DrawArrays*>( geometries[i]->getPrimitiveSet(0) );
+		pDrawArrays->setCount( geometries[i]->getVertexArray()->getNumElements() );
+		pDrawArrays->dirty();
+		geometries[i]->getVertexArray()->dirty();
+		geometries[i]->getColorArray()->dirty();
+		geometries[i]->dirtyBound();
+	}
+	_pChromeGeode->dirtyBound();
+}
@@ -0,0 +1,137 @@
+/*
+	dashboard.h
+	Tiles many plots in one camera pass
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/Camera>
+#include <osg/Geode>
+#include <osg/Geometry>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Lays out plots in a grid of tiles and draws them all in a single
+	 *	pass. Each plot becomes a tile (see Plot::setTile): it draws inside
+	 *	this camera, with its own viewport and data scissor but without a
+	 *	clear or render stage of its own. The backgrounds, grid lines and
+	 *	tick marks of all tiles are merged into three shared geometries,
+	 *	rebuilt only when a tile changes its layout, so adding plots no
+	 *	longer adds passes or chrome draw calls. Labels stay per tile.
+	 *
+	 *	Tiles fill the grid row by row from the top left. Resize the
+	 *	dashboard with the window instead of its plots.
+	 */
+	class OSGTOOLS Dashboard : public osg::Camera {
+	protected:
+		int _width;
+		int _height;
+		int _numColumns;
+
+		std::vector<osg::ref_ptr<Plot>> _plots;
+		std::vector<unsigned int> _numLayouts;		/*!< Layout count of each plot when the chrome was built */
+		bool _bChromeDirty;							/*!< Set when the tiles were added, removed or moved */
+
+		PlotChrome _chrome;							/*!< Chrome of all tiles, in window pixels */
+		osg::ref_ptr<osg::Geode> _pChromeGeode;
+		osg::ref_ptr<osg::Geometry> _pBackgrounds;	/*!< Backgrounds of all tiles */
+		osg::ref_ptr<osg::Geometry> _pMinorLines;	/*!< Minor grid lines of all tiles */
+		osg::ref_ptr<osg::Geometry> _pMajorLines;	/*!< Major grid lines and tick marks of all tiles */
+
+		class ChromeCallback;
+
+		/*!
+		 *	Creates a shared chrome geometry
+		 *	\param	mode		The primitive mode
+		 *	\param	pVertices	The shared vertices
+		 *	\param	pColors		The shared colors, per vertex
+		 *	\param	width		The line width, or 0 for triangles
+		 */
+		osg::Geometry* createChromeGeometry( GLenum mode, osg::Vec3Array* pVertices, osg::Vec4Array* pColors, float width );
+
+		/*!
+		 *	Moves the plots to their tiles
+		 */
+		void layoutTiles();
+
+	public:
+		/*!
+		 *	Creates an empty dashboard
+		 *	\param	width		The width of the window in pixels
+		 *	\param	height		The height of the window in pixels
+		 *	\param	numColumns	The number of tiles per row
+		 */
+		Dashboard( int width, int height, int numColumns=2 );
+
+		/*!
+		 *	Resizes the dashboard and its tiles to a new window size
+		 */
+		void resize( int width, int height );
+
+		int getWidth() { return _width; }
+		int getHeight() { return _height; }
+
+		/*!
+		 *	Sets the number of tiles per row
+		 */
+		void setNumColumns( int numColumns );
+
+		int getNumColumns() { return _numColumns; }
+
+		/*!
+		 *	Adds a plot as the next tile. The plot must not be in the scene
+		 *	elsewhere.
+		 *	\return	True if the plot was added
+		 */
+		bool addPlot( Plot* pPlot );
+
+		/*!
+		 *	Removes a plot and makes it a standalone plot again. The other
+		 *	tiles move up to fill the gap.
+		 *	\return	True if the plot was a tile of the dashboard
+		 */
+		bool removePlot( Plot* pPlot );
+
+		unsigned int getNumPlots() { return _plots.size(); }
+
+		Plot* getPlot( unsigned int index ) { return (index < _plots.size() ? _plots[index].get() : 0); }
+
+		/*!
+		 *	Gets the tile of a plot
+		 *	\param	index	The index of the plot
+		 *	\param	x		The left pixel of the tile in the window
+		 *	\param	y		The bottom pixel of the tile in the window
+		 *	\param	width	The width of the tile
+		 *	\param	height	The height of the tile
+		 *	\return	True if the index is valid
+		 */
+		bool getTile( unsigned int index, int& x, int& y, int& width, int& height );
+
+		/*!
+		 *	Finds the plot under a window pixel, for picking
+		 *	\param	x		The x pixel in the window
+		 *	\param	y		The y pixel in the window
+		 *	\param	plotX	The x pixel in the plot
+		 *	\param	plotY	The y pixel in the plot
+		 *	\return	The plot, or 0 if no tile is at the pixel
+		 */
+		Plot* getPlotAt( float x, float y, float& plotX, float& plotY );
+
+		/*!
+		 *	Rebuilds the shared chrome if a tile changed its layout
+		 */
+		void updateChrome();
+	};
+}
@@ -0,0 +1,128 @@
+/*
+	dataset.cpp
+	Series of bins shared by several histogram views
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "dataset.h"
+#include "shaders.h"
+
+osgtools::Dataset::Dataset() :
+	_seriesMode(Histogram::GROUPED),
+	_bBarsDirty(true)
+{
+	// Built like the bars of a histogram, so its views fill it the same way
+	_pBars = new osg::Geometry();
+	_pBars->setDataVariance( osg::Object::DYNAMIC );
+	_pBars->setVertexArray( new osg::Vec3Array() );
+	_pBars->setColorArray( new osg::Vec4Array() );
+	_pBars->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+	_pBars->addPrimitiveSet( new osg::DrawElementsUInt(GL_TRIANGLES) );
+	Shaders::setupGeometry( _pBars.get() );
+}
+
+int osgtools::Dataset::addSeries( const float* bins, int numBins, const osg::Vec4& color )
+{
+	_series.push_back(Series());
+	if (bins && numBins > 0)
+		_series.back().bins.assign(bins, bins + numBins);
+	_series.back().color = color;
+	updateViews();
+	return _series.size() - 1;
+}
+
+int osgtools::Dataset::addSeries( std::vector<float>& bins, const osg::Vec4& color )
+{
+	return addSeries(bins.empty() ? (const float*)0 : &bins[0], bins.size(), color);
+}
+
+bool osgtools::Dataset::setSeries( int series, const float* bins, int numBins )
+{
+	if (series < 0 || series >= _series.size())
+		return false;
+
+	if (bins && numBins > 0)
+		_series[series].bins.assign(bins, bins + numBins);
+	else
+		_series[series].bins.clear();
+	updateViews();
+	return true;
+}
+
+bool osgtools::Dataset::setSeries( int series, std::vector<float>& bins )
+{
+	return setSeries(series, bins.empty() ? (const float*)0 : &bins[0], bins.size());
+}
+
+bool osgtools::Dataset::setSeriesColor( int series, const osg::Vec4& color )
+{
+	if (series < 0 || series >= _series.size())
+		return false;
+
+	_series[series].color = color;
+	updateViews();
+	return true;
+}
+
+void osgtools::Dataset::clearSeries()
+{
+	_series.clear();
+	updateViews();
+}
+
+bool osgtools::Dataset::setBinEdges( std::vector<float>& edges )
+{
+	// Handle bad input
+	if (edges.size() == 1)
+		return false;
+	for (int i=1; i < edges.size(); i++) {
+		if (!(edges[i - 1] < edges[i]))
+			return false;
+	}
+
+	_binEdges = edges;
+	updateViews();
+	return true;
+}
+
+void osgtools::Dataset::setSeriesMode( Histogram::SeriesMode mode )
+{
+	if (_seriesMode == mode)
+		return;
+
+	_seriesMode = mode;
+	updateViews();
+}
+
+void osgtools::Dataset::addView( Histogram* pView )
+{
+	// Forget views that were deleted
+	for (int i=_views.size() - 1; i >= 0; i--) {
+		if (!_views[i].valid())
+			_views.erase(_views.begin() + i);
+	}
+	_views.push_back(osg::observer_ptr<Histogram>(pView));
+}
+
+void osgtools::Dataset::removeView( Histogram* pView )
+{
+	for (int i=0; i < _views.size(); i++) {
+		if (_views[i] == pView) {
+			_views.erase(_views.begin() + i);
+			return;
+		}
+	}
+}
+
+void osgtools::Dataset::updateViews()
+{
+	// The first view to redraw fills the bars once for all views
+	_bBarsDirty = true;
+	for (int i=0; i < _views.size(); i++) {
+		osg::ref_ptr<Histogram> pView;
+		if (_views[i].lock(pView))
+			pView->updateDataset();
+	}
+}
@@ -0,0 +1,126 @@
+/*
+	dataset.h
+	Series of bins shared by several histogram views
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/Geometry>
+#include <osg/Referenced>
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+// Local
+#include "osgtools.h"
+#include "histogram.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Series of bins shown by several Histograms at once, such as a
+	 *	zoomed view and an overview, or views in different windows (see
+	 *	Histogram::setDataset). The dataset holds the only copy of the bins,
+	 *	which its views read in place, and the only bar geometry, built in
+	 *	plot coordinates and drawn by each view on linear axes through its
+	 *	own range transform. A change is stored and uploaded once, however
+	 *	many views show it; each view then only fits its range and labels.
+	 */
+	class OSGTOOLS Dataset : public osg::Referenced {
+	protected:
+		struct Series {
+			std::vector<float> bins;
+			osg::Vec4 color;
+		};
+		std::vector<Series> _series;
+		std::vector<float> _binEdges;				/*!< x edges of the bins, empty to center bin i on x = i */
+		Histogram::SeriesMode _seriesMode;
+
+		osg::ref_ptr<osg::Geometry> _pBars;			/*!< Bars of all series in plot coordinates */
+		bool _bBarsDirty;							/*!< Set when the bars lag the series */
+
+		std::vector<osg::observer_ptr<Histogram>> _views;
+
+		virtual ~Dataset() {}
+
+		/*!
+		 *	Marks the bars as changed and shows the change in all views
+		 */
+		void updateViews();
+
+	public:
+		Dataset();
+
+		/*!
+		 *	Adds a series of bins
+		 *	\param	bins	The bins, copied
+		 *	\param	numBins	The number of bins
+		 *	\param	color	The color of the bars, shaded darker to the right
+		 *	\return	The index of the series
+		 */
+		int addSeries( const float* bins, int numBins, const osg::Vec4& color );
+		int addSeries( std::vector<float>& bins, const osg::Vec4& color );
+
+		/*!
+		 *	Replaces the bins of a series. The storage of the series is
+		 *	kept, so replacing it with no more bins than before does
+		 *	not allocate.
+		 *	\return	True if the series exists
+		 */
+		bool setSeries( int series, const float* bins, int numBins );
+		bool setSeries( int series, std::vector<float>& bins );
+
+		/*!
+		 *	Sets the color of a series
+		 *	\return	True if the series exists
+		 */
+		bool setSeriesColor( int series, const osg::Vec4& color );
+
+		/*!
+		 *	Removes all series
+		 */
+		void clearSeries();
+
+		int getNumSeries() { return _series.size(); }
+		const std::vector<float>& getBins( int series ) { return _series[series].bins; }
+		const osg::Vec4& getSeriesColor( int series ) { return _series[series].color; }
+
+		/*!
+		 *	Sets the x edges of the bins, as for Histogram::setBinEdges
+		 *	\return	True if the edges are increasing
+		 */
+		bool setBinEdges( std::vector<float>& edges );
+		const std::vector<float>& getBinEdges() { return _binEdges; }
+
+		/*!
+		 *	Sets how the series share a bin
+		 */
+		void setSeriesMode( Histogram::SeriesMode mode );
+		Histogram::SeriesMode getSeriesMode() { return _seriesMode; }
+
+		/*!
+		 *	Adds a view to update on changes. Called by Histogram::setDataset.
+		 */
+		void addView( Histogram* pView );
+
+		/*!
+		 *	Removes a view. Called by Histogram::setDataset.
+		 */
+		void removeView( Histogram* pView );
+
+		/*!
+		 *	Gets the bars shared by the views, filled by the first view to
+		 *	redraw after a change
+		 */
+		osg::Geometry* getBars() { return _pBars.get(); }
+
+		bool isBarsDirty() { return _bBarsDirty; }
+		void clearBarsDirty() { _bBarsDirty = false; }
+	};
+}
@@ -0,0 +1,177 @@
+/*
+	distributionplot.cpp
+	Base of plots summarising distributions side by side
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "distributionplot.h"
+#include "shaders.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const osg::Vec4 osgtools::DistributionPlot::LIGHT_COLOR(0.0, 1.0, 0.0, 1.0);
+const osg::Vec4 osgtools::DistributionPlot::DARK_COLOR(0.0, 0.5, 0.0, 1.0);
+const osg::Vec4 osgtools::DistributionPlot::LINE_COLOR(0.0, 0.0, 0.0, 1.0);
+const float osgtools::DistributionPlot::HALF_WIDTH = 0.4;
+
+osgtools::DistributionPlot::DistributionPlot( int width, int height ) :
+	Plot( width, height, "x", "y" ),
+	_lightColor(LIGHT_COLOR),
+	_darkColor(DARK_COLOR),
+	_lineColor(LINE_COLOR)
+{
+	// Create the geode
+	_pGeode = new osg::Geode();
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
+	_pGeode->getOrCreateStateSet()->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+#endif
+	_pGeode->getOrCreateStateSet()->setMode(GL_BLEND,osg::StateAttribute::ON);
+
+	// Batch the shapes of all distributions, refilled by redraw
+	_pIndices = new osg::DrawElementsUInt(GL_TRIANGLES);
+	_pShapes = new osg::Geometry();
+	_pShapes->setDataVariance( osg::Object::DYNAMIC );
+	_pShapes->setVertexArray( new osg::Vec3Array() );
+	_pShapes->setColorArray( new osg::Vec4Array() );
+	_pShapes->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+	_pShapes->addPrimitiveSet( _pIndices.get() );
+	Shaders::setupGeometry( _pShapes.get() );
+	_pGeode->addDrawable( _pShapes.get() );
+
+	// Add to the plot area
+	addPlotChild( _pGeode.get() );
+}
+
+float osgtools::DistributionPlot::getClampedPixel( int axis, float value, const int* dim ) const
+{
+	return getValuePixel(axis, std::min(std::max(value, _range[axis]), _range[axis + 2]), dim);
+}
+
+int osgtools::DistributionPlot::getDistribution( float x ) const
+{
+	int i = (int)floor(x + 0.5);
+	if (i < 0 || i >= getNumDistributions() || fabs(x - i) > HALF_WIDTH)
+		return -1;
+	return i;
+}
+
+void osgtools::DistributionPlot::beginShapes()
+{
+	// Clearing keeps the storage of the arrays
+	static_cast<osg::Vec3Array*>(_pShapes->getVertexArray())->clear();
+	static_cast<osg::Vec4Array*>(_pShapes->getColorArray())->clear();
+	_pIndices->clear();
+}
+
+void osgtools::DistributionPlot::addQuad( const osg::Vec2& p0, const osg::Vec2& p1, const osg::Vec2& p2, const osg::Vec2& p3,
+	const osg::Vec4& color0, const osg::Vec4& color1 )
+{
+	osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>( _pShapes->getVertexArray() );
+	osg::Vec4Array* colors = static_cast<osg::Vec4Array*>( _pShapes->getColorArray() );
+
+	unsigned int v = vertices->size();
+	vertices->push_back(osg::Vec3(p0, 0));
+	vertices->push_back(osg::Vec3(p1, 0));
+	vertices->push_back(osg::Vec3(p2, 0));
+	vertices->push_back(osg::Vec3(p3, 0));
+	colors->push_back(color0);
+	colors->push_back(color1);
+	colors->push_back(color1);
+	colors->push_back(color0);
+
+	_pIndices->push_back(v + 0);
+	_pIndices->push_back(v + 1);
+	_pIndices->push_back(v + 2);
+	_pIndices->push_back(v + 0);
+	_pIndices->push_back(v + 2);
+	_pIndices->push_back(v + 3);
+}
+
+void osgtools::DistributionPlot::addRect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 )
+{
+	addQuad(osg::Vec2(x0, y0), osg::Vec2(x1, y0), osg::Vec2(x1, y1), osg::Vec2(x0, y1), color0, color1);
+}
+
+void osgtools::DistributionPlot::addLine( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color )
+{
+	// Offset both ends by half the width across the line
+	osg::Vec2 direction(x1 - x0, y1 - y0);
+	if (direction.normalize() == 0)
+		return;
+	osg::Vec2 side(-direction.y() * width / 2, direction.x() * width / 2);
+	addQuad(osg::Vec2(x0, y0) - side, osg::Vec2(x1, y1) - side, osg::Vec2(x1, y1) + side, osg::Vec2(x0, y0) + side, color, color);
+}
+
+void osgtools::DistributionPlot::endShapes()
+{
+	_pShapes->getVertexArray()->dirty();
+	_pShapes->getColorArray()->dirty();
+	_pIndices->dirty();
+
+	_pShapes->dirtyBound();
+	_pGeode->dirtyBound();
+	dirtyRedraw();
+}
+
+void osgtools::DistributionPlot::getDataRange( float& xmin, float& ymin, float& xmax, float& ymax ) const
+{
+	xmin = -1;
+	xmax = getNumDistributions();
+
+	// Pad the values, keeping a log axis positive
+	ymin = ymax = 0;
+	for (int i=0; i < getNumDistributions(); i++) {
+		float min, max;
+		getValueRange(i, min, max);
+		ymin = (i == 0 ? min : std::min(ymin, min));
+		ymax = (i == 0 ? max : std::max(ymax, max));
+	}
+	float pad = (ymax > ymin ? (ymax - ymin) * 0.05f : 1.0f);
+	ymin = (_scales[1]->isValid(ymin - pad) ? ymin - pad : ymin / 2);
+	ymax += pad;
+}
+
+void osgtools::DistributionPlot::fitRange()
+{
+	float xmin, ymin, xmax, ymax;
+	getDataRange(xmin, ymin, xmax, ymax);
+	setRange(xmin, ymin, xmax, ymax);
+}
+
+void osgtools::DistributionPlot::updateDistributions()
+{
+	autoUpdateMajorMinorAxes();
+	fitRange();
+}
+
+void osgtools::DistributionPlot::setColor( const osg::Vec4& color )
+{
+	// Shade like the histogram bars, dark at half the brightness
+	_lightColor = color;
+	_darkColor = osg::Vec4(color.r() * 0.5, color.g() * 0.5, color.b() * 0.5, color.a());
+	redrawData();
+}
+
+void osgtools::DistributionPlot::setLineColor( const osg::Vec4& color )
+{
+	_lineColor = color;
+	redrawData();
+}
+
+void osgtools::DistributionPlot::autoUpdateMajorMinorAxes()
+{
+	if (getNumDistributions() <= 0)
+		return;
+
+	float xmin, ymin, xmax, ymax;
+	getDataRange(xmin, ymin, xmax, ymax);
+
+	// One distribution per x grid line at most
+	float yGrid = getNiceGrid(1, ymin, ymax);
+	setMajorAxisGrid( std::max(getNiceGrid(0, xmin, xmax), 1.0f), yGrid );
+	setMinorAxisGrid( 0, Ticks::getMinorStep(yGrid) );
+}
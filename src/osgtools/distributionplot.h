@@ -0,0 +1,122 @@
+/*
+	distributionplot.h
+	Base of plots summarising distributions side by side
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// OSG
+#include <osg/Geode>
+#include <osg/Geometry>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Draws one shape per distribution, distribution i centered on x = i.
+	 *	The shapes of all distributions are triangles of one geometry, refilled
+	 *	in place, so a plot of hundreds of distributions is a single draw call.
+	 */
+	class OSGTOOLS DistributionPlot : public Plot {
+	protected:
+		osg::Vec4 _lightColor;
+		osg::Vec4 _darkColor;
+		osg::Vec4 _lineColor;
+
+		osg::ref_ptr<osg::Geode> _pGeode;
+		osg::ref_ptr<osg::Geometry> _pShapes;			/*!< The shapes of all distributions */
+		osg::ref_ptr<osg::DrawElementsUInt> _pIndices;
+
+		// Constants
+		static const osg::Vec4 LIGHT_COLOR;
+		static const osg::Vec4 DARK_COLOR;
+		static const osg::Vec4 LINE_COLOR;
+		static const float HALF_WIDTH;					/*!< Half the width of a shape in x units */
+
+		/*!
+		 *	Gets the smallest and largest value of a distribution
+		 */
+		virtual void getValueRange( int i, float& min, float& max ) const = 0;
+
+		/*!
+		 *	Gets the pixel of a value, clamped to the range
+		 */
+		float getClampedPixel( int axis, float value, const int* dim ) const;
+
+		/*!
+		 *	Gets the distribution at an x value
+		 *	\return	The distribution, or -1 if there is none
+		 */
+		int getDistribution( float x ) const;
+
+		/*!
+		 *	Starts refilling the shapes, keeping the storage
+		 */
+		void beginShapes();
+
+		/*!
+		 *	Adds a quad, shaded from color0 on its first and last corners to
+		 *	color1 on the others
+		 */
+		void addQuad( const osg::Vec2& p0, const osg::Vec2& p1, const osg::Vec2& p2, const osg::Vec2& p3,
+			const osg::Vec4& color0, const osg::Vec4& color1 );
+
+		/*!
+		 *	Adds a rectangle, shaded from color0 at x0 to color1 at x1
+		 */
+		void addRect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 );
+
+		/*!
+		 *	Adds a line as a quad of the given width in pixels
+		 */
+		void addLine( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color );
+
+		/*!
+		 *	Uploads the refilled shapes
+		 */
+		void endShapes();
+
+		/*!
+		 *	Gets the range showing all distributions
+		 */
+		void getDataRange( float& xmin, float& ymin, float& xmax, float& ymax ) const;
+
+		/*!
+		 *	Fits the range and grid to the distributions
+		 */
+		void updateDistributions();
+
+	public:
+		DistributionPlot( int width, int height );
+
+		/*!
+		 *	Gets the number of distributions
+		 */
+		virtual int getNumDistributions() const = 0;
+
+		/*!
+		 *	Sets the fill color, shaded darker to the right
+		 */
+		void setColor( const osg::Vec4& color );
+
+		/*!
+		 *	Sets the color of lines, such as medians and whiskers
+		 */
+		void setLineColor( const osg::Vec4& color );
+
+		/*!
+		 *	Sets the range to show all distributions
+		 */
+		void fitRange();
+
+		/*!
+		 *	Automatically update data labels
+		 */
+		void autoUpdateMajorMinorAxes();
+	};
+}
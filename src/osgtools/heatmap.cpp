@@ -0,0 +1,357 @@
+/*
+	heatmap.cpp
+	2D density plot for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "heatmap.h"
+#include "shaders.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <osg/buffered_value>
+
+#ifndef GL_R32F
+#define GL_R32F 0x822E
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+// Constants
+const int osgtools::Heatmap::COLORMAP_SIZE = 256;
+
+/*!
+ *	Uploads the value image once when the texture is created, then only
+ *	the cells changed since the last upload of each context
+ */
+class osgtools::Heatmap::SubloadCallback : public osg::Texture2D::SubloadCallback {
+	struct Region {
+		int x0, y0, x1, y1;
+		Region() : x0(0), y0(0), x1(0), y1(0) {}
+		bool empty() const { return x1 <= x0 || y1 <= y0; }
+	};
+
+	osg::ref_ptr<osg::Image> _pImage;
+	mutable osg::buffered_object<Region> _dirty;	/*!< Cells to upload, per context */
+
+public:
+	SubloadCallback( osg::Image* pImage ) : _pImage(pImage) {}
+
+	void setImage( osg::Image* pImage ) { _pImage = pImage; }
+
+	/*!
+	 *	Marks cells [x0, x1) x [y0, y1) for upload in every context
+	 */
+	void dirty( int x0, int y0, int x1, int y1 ) {
+		for (unsigned int i=0; i < _dirty.size(); i++) {
+			Region& region = _dirty[i];
+			if (region.empty()) {
+				region.x0 = x0; region.y0 = y0;
+				region.x1 = x1; region.y1 = y1;
+			}
+			else {
+				region.x0 = std::min(region.x0, x0); region.y0 = std::min(region.y0, y0);
+				region.x1 = std::max(region.x1, x1); region.y1 = std::max(region.y1, y1);
+			}
+		}
+	}
+
+	virtual void load( const osg::Texture2D& texture, osg::State& state ) const {
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, _pImage->s(), _pImage->t(), 0, GL_RED, GL_FLOAT, _pImage->data());
+		_dirty[state.getContextID()] = Region();
+	}
+
+	virtual void subload( const osg::Texture2D& texture, osg::State& state ) const {
+		Region& region = _dirty[state.getContextID()];
+		if (region.empty())
+			return;
+
+		// Upload the changed rows and columns only
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, _pImage->s());
+		glTexSubImage2D(GL_TEXTURE_2D, 0, region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0,
+			GL_RED, GL_FLOAT, _pImage->data(region.x0, region.y0));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		region = Region();
+	}
+};
+
+osgtools::Heatmap::Heatmap( int width, int height ) :
+	Plot( width, height, "x", "y" ),
+	_numColumns(0),
+	_numRows(0)
+{
+	_valueRange[0] = 0.0;
+	_valueRange[1] = 1.0;
+
+	// Viridis
+	std::vector<osg::Vec4> colors;
+	colors.push_back(osg::Vec4(0.267, 0.005, 0.329, 1.0));
+	colors.push_back(osg::Vec4(0.229, 0.322, 0.546, 1.0));
+	colors.push_back(osg::Vec4(0.128, 0.567, 0.551, 1.0));
+	colors.push_back(osg::Vec4(0.369, 0.789, 0.383, 1.0));
+	colors.push_back(osg::Vec4(0.993, 0.906, 0.144, 1.0));
+
+	createQuad();
+	setColormap(colors);
+	setValueRange(_valueRange[0], _valueRange[1]);
+
+	// Add to the plot area
+	addPlotChild( _pGeode.get() );
+}
+
+void osgtools::Heatmap::createQuad()
+{
+	// Create the value texture, filled by the subload callback
+	_pValues = new osg::Image();
+	_pSubload = new SubloadCallback(_pValues.get());
+	_pValueTexture = new osg::Texture2D();
+	_pValueTexture->setInternalFormat(GL_R32F);
+	_pValueTexture->setSourceFormat(GL_RED);
+	_pValueTexture->setSourceType(GL_FLOAT);
+	_pValueTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+	_pValueTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+	_pValueTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+	_pValueTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+	_pValueTexture->setResizeNonPowerOfTwoHint(false);
+	_pValueTexture->setSubloadCallback(_pSubload.get());
+
+	// Create the colormap texture
+	_pColormapTexture = new osg::Texture1D();
+	_pColormapTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+	_pColormapTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+	_pColormapTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+
+	// Create the quad
+	_pQuad = new osg::Geometry();
+	_pQuad->setDataVariance( osg::Object::DYNAMIC );
+	_pQuad->setVertexArray( new osg::Vec3Array(4) );
+	_pQuad->setTexCoordArray( 0, new osg::Vec2Array(4) );
+
+	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
+	pColors->push_back(osg::Vec4(1.0, 1.0, 1.0, 1.0));
+	_pQuad->setColorArray( pColors.get() );
+	_pQuad->setColorBinding( osg::Geometry::BIND_OVERALL );
+	_pQuad->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( _pQuad.get() );
+
+	_pGeode = new osg::Geode();
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
+	_pGeode->getOrCreateStateSet()->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+#endif
+	_pGeode->addDrawable( _pQuad.get() );
+	Shaders::setColormap(_pGeode->getOrCreateStateSet(), _pValueTexture.get(), _pColormapTexture.get());
+}
+
+bool osgtools::Heatmap::setSize( int numColumns, int numRows )
+{
+	if (numColumns <= 0 || numRows <= 0)
+		return false;
+	_numColumns = numColumns;
+	_numRows = numRows;
+
+	// Replace the values; the texture is created again at the new size
+	_pValues = new osg::Image();
+	_pValues->allocateImage(_numColumns, _numRows, 1, GL_RED, GL_FLOAT);
+	memset(_pValues->data(), 0, _pValues->getTotalSizeInBytes());
+	_pSubload->setImage(_pValues.get());
+	_pValueTexture->setTextureSize(_numColumns, _numRows);
+	_pValueTexture->dirtyTextureObject();
+
+	// Show all cells
+	setMajorAxisGrid( std::max(getNiceGrid(0, 0, _numColumns), 1.0f), std::max(getNiceGrid(1, 0, _numRows), 1.0f) );
+	setMinorAxisGrid( 0, 0 );
+	setRange(0, 0, _numColumns, _numRows);
+	return true;
+}
+
+bool osgtools::Heatmap::setValues( const float* values )
+{
+	return setCells(0, 0, _numColumns, _numRows, values);
+}
+
+bool osgtools::Heatmap::setCells( int column, int row, int numColumns, int numRows, const float* values )
+{
+	if (!values || column < 0 || row < 0 || numColumns <= 0 || numRows <= 0 ||
+		column + numColumns > _numColumns || row + numRows > _numRows)
+		return false;
+
+	// Copy the block row by row
+	for (int j=0; j < numRows; j++)
+		memcpy(_pValues->data(column, row + j), values + j * numColumns, numColumns * sizeof(float));
+
+	_pSubload->dirty(column, row, column + numColumns, row + numRows);
+	dirtyRedraw();
+	return true;
+}
+
+float osgtools::Heatmap::getValue( int column, int row )
+{
+	if (column < 0 || row < 0 || column >= _numColumns || row >= _numRows)
+		return 0.0;
+	return *(float*)_pValues->data(column, row);
+}
+
+void osgtools::Heatmap::setValueRange( float min, float max )
+{
+	_valueRange[0] = min;
+	_valueRange[1] = max;
+	Shaders::setValueRange(_pGeode->getOrCreateStateSet(), min, max);
+	dirtyRedraw();
+}
+
+void osgtools::Heatmap::autoValueRange()
+{
+	if (_numColumns <= 0 || _numRows <= 0)
+		return;
+
+	// Find the extent of the values, skipping empty cells
+	const float* values = (const float*)_pValues->data();
+	int numValues = _numColumns * _numRows;
+	float minval = 0.0, maxval = 0.0;
+	bool bFound = false;
+	for (int i=0; i < numValues; i++) {
+		if (values[i] != values[i])
+			continue;
+		if (!bFound || values[i] < minval) minval = values[i];
+		if (!bFound || values[i] > maxval) maxval = values[i];
+		bFound = true;
+	}
+	setValueRange(minval, maxval);
+}
+
+void osgtools::Heatmap::setColormap( const std::vector<osg::Vec4>& colors )
+{
+	if (colors.size() < 2)
+		return;
+
+	// Interpolate the colors into the texture
+	_colormap.resize(COLORMAP_SIZE);
+	osg::ref_ptr<osg::Image> pImage = new osg::Image();
+	pImage->allocateImage(COLORMAP_SIZE, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+	for (int i=0; i < COLORMAP_SIZE; i++) {
+		float t = (float)i / (COLORMAP_SIZE - 1) * (colors.size() - 1);
+		int k = std::min((int)t, (int)colors.size() - 2);
+		_colormap[i] = colors[k] * (1.0 - (t - k)) + colors[k + 1] * (t - k);
+
+		unsigned char* pTexel = pImage->data(i);
+		for (int c=0; c < 4; c++)
+			pTexel[c] = (unsigned char)(std::min(std::max(_colormap[i][c], 0.0f), 1.0f) * 255 + 0.5);
+	}
+	_pColormapTexture->setImage(pImage.get());
+	dirtyRedraw();
+}
+
+osg::Vec4 osgtools::Heatmap::getColor( float value ) const
+{
+	float range = _valueRange[1] - _valueRange[0];
+	float t = (value - _valueRange[0]) / (range > 0 ? range : 1.0);
+	t = std::min(std::max(t, 0.0f), 1.0f);
+	return _colormap[(int)(t * (COLORMAP_SIZE - 1) + 0.5)];
+}
+
+void osgtools::Heatmap::redraw()
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "redraw");
+
+	osg::Vec3Array* pVertices = static_cast<osg::Vec3Array*>( _pQuad->getVertexArray() );
+	osg::Vec2Array* pTexCoords = static_cast<osg::Vec2Array*>( _pQuad->getTexCoordArray(0) );
+
+	// Clip the cells to the range
+	float x0 = std::max(0.0f, _range[0]);
+	float y0 = std::max(0.0f, _range[1]);
+	float x1 = std::min((float)_numColumns, _range[2]);
+	float y1 = std::min((float)_numRows, _range[3]);
+
+	if (_numColumns <= 0 || _numRows <= 0 || x1 <= x0 || y1 <= y0) {
+		// Nothing visible
+		for (int i=0; i < 4; i++)
+			(*pVertices)[i].set(0, 0, 0);
+	}
+	else {
+		float px0 = getValuePixel(0, x0, _layoutDim);
+		float py0 = getValuePixel(1, y0, _layoutDim);
+		float px1 = getValuePixel(0, x1, _layoutDim);
+		float py1 = getValuePixel(1, y1, _layoutDim);
+		(*pVertices)[0].set(px0, py0, 0);
+		(*pVertices)[1].set(px1, py0, 0);
+		(*pVertices)[2].set(px1, py1, 0);
+		(*pVertices)[3].set(px0, py1, 0);
+
+		(*pTexCoords)[0].set(x0 / _numColumns, y0 / _numRows);
+		(*pTexCoords)[1].set(x1 / _numColumns, y0 / _numRows);
+		(*pTexCoords)[2].set(x1 / _numColumns, y1 / _numRows);
+		(*pTexCoords)[3].set(x0 / _numColumns, y1 / _numRows);
+	}
+	pVertices->dirty();
+	pTexCoords->dirty();
+	_pQuad->dirtyBound();
+	_pGeode->dirtyBound();
+	dirtyRedraw();
+}
+
+void osgtools::Heatmap::drawVectorData( VectorCanvas& canvas )
+{
+	// Cells partly in the range are clipped to it
+	int c0 = std::max(0, (int)floor(_range[0]));
+	int r0 = std::max(0, (int)floor(_range[1]));
+	int c1 = std::min(_numColumns, (int)ceil(_range[2]));
+	int r1 = std::min(_numRows, (int)ceil(_range[3]));
+
+	for (int r=r0; r < r1; r++) {
+		const float* values = (const float*)_pValues->data(0, r);
+		float y0 = getValuePixel(1, std::max((float)r, _range[1]), _plotDim);
+		float y1 = getValuePixel(1, std::min((float)r + 1, _range[3]), _plotDim);
+
+		// Merge runs of cells with the same color
+		int start = c0;
+		while (start < c1) {
+			if (values[start] != values[start]) {
+				start++;
+				continue;
+			}
+			osg::Vec4 color = getColor(values[start]);
+			int end = start + 1;
+			while (end < c1 && values[end] == values[end] && getColor(values[end]) == color)
+				end++;
+
+			float x0 = getValuePixel(0, std::max((float)start, _range[0]), _plotDim);
+			float x1 = getValuePixel(0, std::min((float)end, _range[2]), _plotDim);
+			canvas.rect(x0, y0, x1, y1, color, color);
+			start = end;
+		}
+	}
+}
+
+bool osgtools::Heatmap::pick( float x, float y, PlotPick& pick )
+{
+	if (x < _plotDim[0] || x > _plotDim[0] + _plotDim[2] || y < _plotDim[1] || y > _plotDim[1] + _plotDim[3])
+		return false;
+
+	int column = (int)floor(getXPixelValue(x));
+	int row = (int)floor(getYPixelValue(y));
+	if (column < 0 || row < 0 || column >= _numColumns || row >= _numRows)
+		return false;
+
+	pick.series = 0;
+	pick.index = column;
+	pick.row = row;
+	pick.x = column;
+	pick.y = row;
+	pick.value = getValue(column, row);
+	return true;
+}
+
+std::string osgtools::Heatmap::getPickText( const PlotPick& pick )
+{
+	char s[64];
+	snprintf(s, sizeof(s), "(%d, %d): %g", pick.index, pick.row, pick.value);
+	return s;
+}
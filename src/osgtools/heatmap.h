@@ -0,0 +1,141 @@
+/*
+	heatmap.h
+	2D density plot for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/Texture1D>
+#include <osg/Texture2D>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Plots a grid of cells colored by value. The values live in one float
+	 *	texture drawn on a single quad and mapped to color in the shader, so
+	 *	drawing costs the same for any number of cells. Changed cells are
+	 *	uploaded as a sub-image on the next frame.
+	 *
+	 *	Cells are addressed by (column, row), with row 0 at the bottom; cell
+	 *	(c, r) covers [c, c+1] x [r, r+1] in plot coordinates. Update the
+	 *	cells between frames (or from an update callback).
+	 */
+	class OSGTOOLS Heatmap : public Plot {
+	protected:
+		int _numColumns;
+		int _numRows;
+		float _valueRange[2];						/*!< Values mapped to the ends of the colormap */
+		std::vector<osg::Vec4> _colormap;			/*!< Colors of the colormap texture */
+
+		osg::ref_ptr<osg::Geode> _pGeode;
+		osg::ref_ptr<osg::Geometry> _pQuad;			/*!< Quad covering the visible cells */
+		osg::ref_ptr<osg::Image> _pValues;			/*!< Cell values, one float per cell */
+		osg::ref_ptr<osg::Texture2D> _pValueTexture;
+		osg::ref_ptr<osg::Texture1D> _pColormapTexture;
+
+		class SubloadCallback;
+		osg::ref_ptr<SubloadCallback> _pSubload;	/*!< Uploads the changed cells */
+
+		// Constants
+		static const int COLORMAP_SIZE;
+
+		/*!
+		 *	Creates the quad and textures
+		 */
+		void createQuad();
+
+		/*!
+		 *	Gets the colormap color of a value
+		 */
+		osg::Vec4 getColor( float value ) const;
+
+		/*!
+		 *	Draws the cells of the vector output, merging equal neighbours in
+		 *	a row into one rectangle
+		 */
+		virtual void drawVectorData( VectorCanvas& canvas );
+
+	public:
+		Heatmap( int width, int height );
+
+		/*!
+		 *	Sets the number of cells. The values are cleared to zero and the
+		 *	range is set to cover all cells.
+		 *	\param	numColumns	The number of columns
+		 *	\param	numRows		The number of rows
+		 *	\return	True if the size is valid
+		 */
+		bool setSize( int numColumns, int numRows );
+
+		int getNumColumns() { return _numColumns; }
+		int getNumRows() { return _numRows; }
+
+		/*!
+		 *	Sets all cells
+		 *	\param	values	numColumns * numRows values, row by row from the bottom
+		 *	\return	True if the heatmap has cells
+		 */
+		bool setValues( const float* values );
+
+		/*!
+		 *	Sets a block of cells. Only the block is uploaded.
+		 *	\param	column		The first column of the block
+		 *	\param	row			The first row of the block
+		 *	\param	numColumns	The columns of the block
+		 *	\param	numRows		The rows of the block
+		 *	\param	values		numColumns * numRows values, row by row from the bottom
+		 *	\return	True if the block is inside the heatmap
+		 */
+		bool setCells( int column, int row, int numColumns, int numRows, const float* values );
+
+		/*!
+		 *	Gets the value of a cell
+		 */
+		float getValue( int column, int row );
+
+		/*!
+		 *	Sets the values mapped to the first and last colors
+		 */
+		void setValueRange( float min, float max );
+
+		/*!
+		 *	Sets the value range to the smallest and largest value
+		 */
+		void autoValueRange();
+
+		/*!
+		 *	Sets the colormap, interpolating between the given colors
+		 *	\param	colors	At least two colors, from low to high values
+		 */
+		void setColormap( const std::vector<osg::Vec4>& colors );
+
+		/*!
+		 *	Fits the quad to the visible cells
+		 */
+		virtual void redraw();
+
+		/*!
+		 *	Finds the cell at a pixel. The index is the column.
+		 */
+		virtual bool pick( float x, float y, PlotPick& pick );
+
+		/*!
+		 *	Formats the cell and value of a pick
+		 */
+		virtual std::string getPickText( const PlotPick& pick );
+	};
+}
@@ -7,16 +7,127 @@
 */
 
 #include "histogram.h"
+#include "dataset.h"
+#include "shaders.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <osg/NodeVisitor>
+#include <osg/observer_ptr>
+
+/*!
+ *	Advances the transition uniform with the frame time, easing in and out,
+ *	and keeps the histogram redrawing until the transition ends
+ */
+class osgtools::Histogram::TransitionCallback : public osg::UniformCallback {
+	osg::observer_ptr<Histogram> _histogram;
+	double _duration;
+	double _start;				/*!< Frame time the transition started */
+	bool _bRestart;				/*!< Start at the next frame */
+
+public:
+	TransitionCallback( Histogram* pHistogram ) :
+		_histogram(pHistogram),
+		_duration(0),
+		_start(0),
+		_bRestart(false)
+	{}
+
+	void setDuration( double duration ) { _duration = duration; }
+	void restart() { _bRestart = true; }
+
+	virtual void operator()( osg::Uniform* pUniform, osg::NodeVisitor* pNv ) {
+		if (!pNv || !pNv->getFrameStamp())
+			return;
+
+		double now = pNv->getFrameStamp()->getReferenceTime();
+		if (_bRestart) {
+			_start = now;
+			_bRestart = false;
+		}
+		float t = (_duration > 0 ? std::min((now - _start) / _duration, 1.0) : 1.0);
+		t = t * t * (3 - 2 * t);
+
+		float current;
+		pUniform->get(current);
+		if (t == current)
+			return;
+		pUniform->set(t);
+
+		osg::ref_ptr<Histogram> pHistogram;
+		if (_histogram.lock(pHistogram))
+			pHistogram->dirtyRedraw();
+	}
+};
+
+// Constants
+const osg::Vec4 osgtools::Histogram::BAR_LIGHT_COLOR(0.0, 1.0, 0.0, 1.0);
+const osg::Vec4 osgtools::Histogram::BAR_DARK_COLOR(0.0, 0.5, 0.0, 1.0);
+const osg::Vec4 osgtools::Histogram::DENSITY_COLOR(1.0, 1.0, 1.0, 1.0);
+const float osgtools::Histogram::DENSITY_WIDTH = 2.0;
+
+osgtools::Histogram::Histogram() :
+	_seriesMode(GROUPED),
+	_densitySeries(-1),
+	_densityBandwidth(0),
+	_bDensityDirty(false),
+	_transitionDuration(0),
+	_bTransitionPending(false),
+	_bDatasetFitted(false)
+{
+}
 
 osgtools::Histogram::Histogram( int width, int height ) :
-	Plot( width, height, "x", "y" )
+	Plot( width, height, "x", "y" ),
+	_seriesMode(GROUPED),
+	_densitySeries(-1),
+	_densityBandwidth(0),
+	_bDensityDirty(false),
+	_densityColor(DENSITY_COLOR),
+	_transitionDuration(0),
+	_bTransitionPending(false),
+	_bDatasetFitted(false)
 {
 	// Create the geode
 	_pGeode = new osg::Geode();
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
 	_pGeode->getOrCreateStateSet()->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+#endif
+	// Overlaid series may be translucent
+	_pGeode->getOrCreateStateSet()->setMode(GL_BLEND,osg::StateAttribute::ON);
 
-	// Add to the scene graph
-	addChild( _pGeode.get() );
+	// Batch the bars of all series, filled in place by redraw
+	_pBarIndices = new osg::DrawElementsUInt(GL_TRIANGLES);
+	_pBars = new osg::Geometry();
+	_pBars->setDataVariance( osg::Object::DYNAMIC );
+	_pBars->setVertexArray( new osg::Vec3Array() );
+	_pBars->setColorArray( new osg::Vec4Array() );
+	_pBars->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+	_pBars->addPrimitiveSet( _pBarIndices.get() );
+	Shaders::setupGeometry( _pBars.get() );
+	_pGeode->addDrawable( _pBars.get() );
+
+	// The density overlay, drawn over the bars
+	_pDensity = new osg::Geometry();
+	_pDensity->setDataVariance( osg::Object::DYNAMIC );
+	_pDensity->setVertexArray( new osg::Vec3Array() );
+	osg::ref_ptr<osg::Vec4Array> pDensityColors = new osg::Vec4Array();
+	pDensityColors->push_back(_densityColor);
+	_pDensity->setColorArray( pDensityColors.get() );
+	_pDensity->setColorBinding( osg::Geometry::BIND_OVERALL );
+	_pDensity->addPrimitiveSet( new osg::DrawArrays(GL_LINE_STRIP, 0, 0) );
+	Shaders::setLineWidth( _pDensity->getOrCreateStateSet(), DENSITY_WIDTH );
+	Shaders::setupGeometry( _pDensity.get() );
+	_pGeode->addDrawable( _pDensity.get() );
+
+	// Add to the plot area
+	addPlotChild( _pGeode.get() );
+}
+
+osgtools::Histogram::~Histogram()
+{
 }
 
 bool osgtools::Histogram::setHistogram( std::vector<float>& bins )
@@ -25,86 +136,700 @@ bool osgtools::Histogram::setHistogram( std::vector<float>& bins )
 	if (bins.size() == 0)
 		return false;
 
-	// Update the bins
-	_bins.clear();
-	_bins = bins;
+	return setHistogram(&bins[0], bins.size());
+}
 
-	// Get the max element
-	float maxval = _bins[0];
-	for (int i=1; i < _bins.size(); i++) {
-		if (maxval < _bins[i])
-			maxval = _bins[i];
-	}
+bool osgtools::Histogram::updateHistogram()
+{
+	_bDensityDirty = true;
+	_bTransitionPending = true;
+	_series[0].lightColor = BAR_LIGHT_COLOR;
+	_series[0].darkColor = BAR_DARK_COLOR;
 
 	// Resize the graph
 	//int majorTick = (int)maxval/3;
 	//setMajorAxisGrid(1, (float)(majorTick));
 	//setMinorAxisGrid(1, (float)majorTick/2);
 	autoUpdateMajorMinorAxes();
-	setRange(-1, 0, bins.size(), maxval);
+	fitRange();
 	
 
 	return true;
 }
 
-void osgtools::Histogram::redraw()
+int osgtools::Histogram::addSeries( std::vector<float>& bins, const osg::Vec4& color )
+{
+	return addSeries(bins.empty() ? (const float*)0 : &bins[0], bins.size(), color);
+}
+
+int osgtools::Histogram::updateAddedSeries( const osg::Vec4& color )
+{
+	_bDensityDirty = true;
+	_bTransitionPending = true;
+	setSeriesColor(_series.size() - 1, color);
+
+	autoUpdateMajorMinorAxes();
+	fitRange();
+	return _series.size() - 1;
+}
+
+bool osgtools::Histogram::setSeries( int series, std::vector<float>& bins )
+{
+	return setSeries(series, bins.empty() ? (const float*)0 : &bins[0], bins.size());
+}
+
+void osgtools::Histogram::updateSeries()
+{
+	_bDensityDirty = true;
+	_bTransitionPending = true;
+	autoUpdateMajorMinorAxes();
+	fitRange();
+}
+
+int osgtools::Histogram::addDatasetSeries( const osg::Vec4& color )
+{
+	return _pDataset->addSeries(_datasetBins, color);
+}
+
+bool osgtools::Histogram::setDatasetSeries( int series )
+{
+	return _pDataset->setSeries(series, _datasetBins);
+}
+
+bool osgtools::Histogram::setDatasetHistogram()
+{
+	// Keep the storage of a single series, or replace them all
+	if (_pDataset->getNumSeries() == 1)
+		return _pDataset->setSeries(0, _datasetBins);
+
+	_pDataset->clearSeries();
+	_pDataset->addSeries(_datasetBins, BAR_LIGHT_COLOR);
+	return true;
+}
+
+void osgtools::Histogram::setSeriesColor( int series, const osg::Vec4& color )
+{
+	if (series < 0 || series >= _series.size())
+		return;
+	if (_pDataset.valid()) {
+		_pDataset->setSeriesColor(series, color);
+		return;
+	}
+
+	shadeSeries(series, color);
+	redrawData();
+}
+
+void osgtools::Histogram::shadeSeries( int series, const osg::Vec4& color )
+{
+	// Shade like the default bars, dark at half the brightness
+	_series[series].lightColor = color;
+	_series[series].darkColor = osg::Vec4(color.r() * 0.5, color.g() * 0.5, color.b() * 0.5, color.a());
+}
+
+void osgtools::Histogram::setDataset( Dataset* pDataset )
+{
+	if (pDataset == _pDataset.get())
+		return;
+
+	if (_pDataset.valid()) {
+		_pDataset->removeView(this);
+		_pSharedGeode->removeDrawables(0, _pSharedGeode->getNumDrawables());
+	}
+	_pDataset = pDataset;
+
+	if (!_pDataset.valid()) {
+		clearSeries();
+		return;
+	}
+
+	// Draw the shared bars through a transform of their own
+	if (!_pSharedTransform.valid()) {
+		_pSharedGeode = new osg::Geode();
+		_pSharedGeode->setStateSet( _pGeode->getStateSet() );
+		_pSharedTransform = new osg::MatrixTransform();
+		_pSharedTransform->setDataVariance( osg::Object::DYNAMIC );
+		_pSharedTransform->addChild( _pSharedGeode.get() );
+		addPlotChild( _pSharedTransform.get() );
+	}
+	_pSharedGeode->addDrawable( _pDataset->getBars() );
+	_pDataset->addView(this);
+	_bDatasetFitted = false;
+	updateDataset();
+}
+
+void osgtools::Histogram::updateDataset()
+{
+	if (!_pDataset.valid())
+		return;
+
+	readDataset();
+	_bDensityDirty = true;
+	_bTransitionPending = true;
+	autoUpdateMajorMinorAxes();
+
+	// Fit the first bins shown, then keep the range of the view
+	if (!_bDatasetFitted) {
+		fitRange();
+		_bDatasetFitted = (getNumBins() > 0);
+	}
+	else
+		setRange(_range[0], _range[1], _range[2], _range[3]);
+}
+
+void osgtools::Histogram::readDataset()
+{
+	// Read the bins of the dataset in place
+	int numSeries = _pDataset->getNumSeries();
+	_series.resize(numSeries);
+	for (int s=0; s < numSeries; s++) {
+		const std::vector<float>& bins = _pDataset->getBins(s);
+		_series[s].bins.view(bins.empty() ? (const float*)0 : &bins[0], bins.size());
+		shadeSeries(s, _pDataset->getSeriesColor(s));
+	}
+	_binEdges = _pDataset->getBinEdges();
+	_seriesMode = _pDataset->getSeriesMode();
+}
+
+bool osgtools::Histogram::isSharingBars() const
+{
+	return _pDataset.valid()
+		&& dynamic_cast<const LinearScale*>(_scales[0].get())
+		&& dynamic_cast<const LinearScale*>(_scales[1].get());
+}
+
+void osgtools::Histogram::updateSharedBars()
+{
+	// The first view to redraw after a change fills the bars for all views
+	if (_pDataset->isBarsDirty()) {
+		fillBars(_pDataset->getBars(), 0);
+		_pDataset->clearBarsDirty();
+	}
+
+	// Map plot coordinates onto the layout at the current range
+	double size[2];
+	for (int axis=0; axis < 2; axis++) {
+		double rangeSize = _scaledRange[axis + 2] - _scaledRange[axis];
+		size[axis] = (rangeSize != 0 ? _layoutDim[axis + 2] / rangeSize : 1.0);
+	}
+	_pSharedTransform->setMatrix(
+		osg::Matrix::translate(-_scaledRange[0], -_scaledRange[1], 0) *
+		osg::Matrix::scale(size[0], size[1], 1.0) *
+		osg::Matrix::translate(_layoutDim[0], _layoutDim[1], 0) );
+}
+
+void osgtools::Histogram::clearSeries()
+{
+	if (_pDataset.valid()) {
+		_pDataset->clearSeries();
+		return;
+	}
+
+	_series.clear();
+	_bDensityDirty = true;
+	_bTransitionPending = true;
+	redrawData();
+}
+
+void osgtools::Histogram::setDensityOverlay( int series, float bandwidth )
+{
+	_densitySeries = series;
+	_densityBandwidth = std::max(bandwidth, 0.0f);
+	_bDensityDirty = true;
+	redrawData();
+}
+
+void osgtools::Histogram::setDensityColor( const osg::Vec4& color )
+{
+	_densityColor = color;
+	if (_pDensity.valid()) {
+		osg::Vec4Array* colors = static_cast<osg::Vec4Array*>( _pDensity->getColorArray() );
+		(*colors)[0] = color;
+		colors->dirty();
+	}
+	dirtyRedraw();
+}
+
+void osgtools::Histogram::setTransitionDuration( double seconds )
+{
+	if (!_pBars.valid())
+		return;
+
+	_transitionDuration = std::max(seconds, 0.0);
+	osg::StateSet* pStateSet = _pBars->getOrCreateStateSet();
+	if (_transitionDuration > 0 && !_pTransition.valid()) {
+		// Start with the previous positions on the bars
+		osg::ref_ptr<osg::Vec3Array> pPrevious = new osg::Vec3Array(*static_cast<osg::Vec3Array*>( _pBars->getVertexArray() ));
+		pPrevious->setDataVariance( osg::Object::DYNAMIC );
+		_pBars->setVertexAttribArray( Shaders::PREVIOUS_VERTEX_LOCATION, pPrevious.get(), osg::Array::BIND_PER_VERTEX );
+
+		_pTransitionCallback = new TransitionCallback(this);
+		_pTransition = new osg::Uniform("osgtools_Transition", 1.0f);
+		_pTransition->setDataVariance( osg::Object::DYNAMIC );
+		_pTransition->setUpdateCallback( _pTransitionCallback.get() );
+		pStateSet->addUniform( _pTransition.get() );
+		pStateSet->setAttributeAndModes( Shaders::getTransitionProgram(), osg::StateAttribute::ON );
+	}
+	else if (_transitionDuration == 0 && _pTransition.valid()) {
+		pStateSet->removeUniform( _pTransition.get() );
+		pStateSet->removeAttribute( Shaders::getTransitionProgram() );
+		_pBars->setVertexAttribArray( Shaders::PREVIOUS_VERTEX_LOCATION, 0 );
+		_pTransition = 0;
+		_pTransitionCallback = 0;
+	}
+
+	if (_pTransitionCallback.valid())
+		_pTransitionCallback->setDuration(_transitionDuration);
+}
+
+void osgtools::Histogram::boxBlur( const float* in, float* out, int n, int radius )
+{
+	// Slide a window of 2 * radius + 1 values
+	double sum = 0;
+	float scale = 1.0f / (2 * radius + 1);
+	for (int i=0; i < std::min(radius, n); i++)
+		sum += in[i];
+	for (int i=0; i < n; i++) {
+		if (i + radius < n)
+			sum += in[i + radius];
+		if (i - radius - 1 >= 0)
+			sum -= in[i - radius - 1];
+		out[i] = sum * scale;
+	}
+}
+
+void osgtools::Histogram::updateDensity()
+{
+	if (!_bDensityDirty)
+		return;
+	_bDensityDirty = false;
+
+	_density.clear();
+	if (_densitySeries < 0 || _densitySeries >= _series.size())
+		return;
+
+	const HistogramBins& bins = _series[_densitySeries].bins;
+	int n = bins.size();
+	_density.resize(n);
+	_densityScratch.resize(n);
+	for (int i=0; i < n; i++)
+		_density[i] = bins[i];
+	if (n == 0)
+		return;
+
+	// Three boxes of odd widths whose variances add up to the kernel's
+	float variance = _densityBandwidth * _densityBandwidth;
+	int lower = (int)floor(sqrt(4 * variance + 1));
+	if (lower % 2 == 0)
+		lower--;
+	int numLower = (int)floor((12 * variance - 3 * lower * lower - 12 * lower - 9) / (-4.0 * lower - 4) + 0.5);
+	for (int pass=0; pass < 3; pass++) {
+		int width = (pass < numLower ? lower : lower + 2);
+		boxBlur(&_density[0], &_densityScratch[0], n, width / 2);
+		_density.swap(_densityScratch);
+	}
+}
+
+void osgtools::Histogram::setSeriesMode( SeriesMode mode )
+{
+	if (_pDataset.valid()) {
+		_pDataset->setSeriesMode(mode);
+		return;
+	}
+	if (_seriesMode == mode)
+		return;
+
+	// Stacking changes the height of the bars
+	_seriesMode = mode;
+	_bTransitionPending = true;
+	autoUpdateMajorMinorAxes();
+	fitRange();
+}
+
+bool osgtools::Histogram::setBinEdges( std::vector<float>& edges )
+{
+	if (_pDataset.valid())
+		return _pDataset->setBinEdges(edges);
+
+	// Handle bad input
+	if (edges.size() == 1)
+		return false;
+	for (int i=1; i < edges.size(); i++) {
+		if (!(edges[i - 1] < edges[i]))
+			return false;
+	}
+
+	_binEdges = edges;
+	autoUpdateMajorMinorAxes();
+	fitRange();
+	return true;
+}
+
+bool osgtools::Histogram::setSketch( const QuantileSketch& sketch, int numBins )
+{
+	// Handle bad input
+	if (numBins <= 0)
+		return false;
+
+	// Edges of the current range, in the scale of the x axis
+	_scales[0]->getBinEdges(_range[0], _range[2], numBins, _binEdges);
+	sketch.getBins(_binEdges, _sketchBins);
+	if (_pDataset.valid())
+		_pDataset->setBinEdges(_binEdges);
+	return setHistogram(_sketchBins);
+}
+
+void osgtools::Histogram::getDataRange( float& xmin, float& ymin, float& xmax, float& ymax ) const
+{
+	// Bins are centered on their index, or span their edges
+	xmin = -1;
+	xmax = getNumBins();
+	if (!_binEdges.empty()) {
+		xmin = _binEdges.front();
+		xmax = _binEdges.back();
+	}
+
+	// Start at zero, or below the lowest bar on a log axis
+	ymin = 0;
+	ymax = getMaxValue();
+	if (!_scales[1]->isValid(ymin)) {
+		float minval = 0;
+		for (int s=0; s < _series.size(); s++) {
+			for (int i=0; i < _series[s].bins.size(); i++) {
+				float value = _series[s].bins[i];
+				if (value > 0 && (minval == 0 || value < minval))
+					minval = value;
+			}
+		}
+		ymin = (minval > 0 ? minval / 2 : 1);
+		ymax = std::max(ymax, ymin * 10);
+	}
+}
+
+void osgtools::Histogram::fitRange()
+{
+	float xmin, ymin, xmax, ymax;
+	getDataRange(xmin, ymin, xmax, ymax);
+	setRange(xmin, ymin, xmax, ymax);
+}
+
+int osgtools::Histogram::getNumBins() const
+{
+	int numBins = 0;
+	for (int s=0; s < _series.size(); s++)
+		numBins = std::max(numBins, (int)_series[s].bins.size());
+	return numBins;
+}
+
+float osgtools::Histogram::getMaxValue() const
 {
-	// Clear the active Geometry
-	if (_histogramGeo.size() > 0) {
-		for (int i=0; i<_histogramGeo.size(); i++) {
-			_pGeode->removeDrawable( _histogramGeo[i].release() );
+	float maxval = 0;
+	int numBins = getNumBins();
+	for (int i=0; i < numBins; i++) {
+		float total = 0;
+		for (int s=0; s < _series.size(); s++) {
+			if (i >= _series[s].bins.size())
+				continue;
+			if (_seriesMode == STACKED)
+				total += _series[s].bins[i];
+			else
+				total = std::max(total, _series[s].bins[i]);
 		}
-		_histogramGeo.clear();
+		maxval = std::max(maxval, total);
 	}
+	return maxval;
+}
+
+void osgtools::Histogram::redraw()
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "redraw");
+
+	if (!_pBars.valid())
+		return;
 	
-	//Construct the rectangles
-	for (int i=0; i < _bins.size(); i++) {
-		float startx = getXValuePixel(i-.45);
-		float endx = getXValuePixel(i+.45);
-		float starty = getYValuePixel(0);
-		float endy = getYValuePixel(_bins[i]);
-
-		startx = (startx == -1 ? getXValuePixel(_range[0]) : startx);
-		endx = (endx == -1 ? getXValuePixel(_range[2]) : endx);
-		starty = (starty == -1 ? getYValuePixel(_range[1]) : starty);
-		endy = (endy == -1 ? getYValuePixel(_range[3]) : endy);
-
-		osg::ref_ptr<osg::Geometry> rectangle = new osg::Geometry();
-		osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array();
-		vertices->push_back(osg::Vec3( startx, starty, 0));
-		vertices->push_back(osg::Vec3( endx, starty, 0));
-		vertices->push_back(osg::Vec3( endx, endy, 0));
-		vertices->push_back(osg::Vec3( startx, endy, 0));
-		rectangle->setVertexArray(vertices.release());
-
-		osg::ref_ptr<osg::Vec4Array> colors = new osg::Vec4Array();
-		colors->push_back(osg::Vec4(0,1,0,1));
-		colors->push_back(osg::Vec4(0,.5,0,1));
-		colors->push_back(osg::Vec4(0,.5,0,1));
-		colors->push_back(osg::Vec4(0,1,0,1));
-		rectangle->setColorArray( colors.release() );
-		rectangle->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
-		rectangle->addPrimitiveSet( new osg::DrawArrays(GL_QUADS, 0, 4) );
-
-		_pGeode->addDrawable( rectangle.get() );
-		_histogramGeo.push_back( rectangle );
+	osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>( _pBars->getVertexArray() );
+	bool bShared = isSharingBars();
+
+	// A transition starts from the bars as shown, part way through any
+	// running transition
+	osg::Vec3Array* previous = (_pTransition.valid()
+		? static_cast<osg::Vec3Array*>( _pBars->getVertexAttribArray(Shaders::PREVIOUS_VERTEX_LOCATION) ) : 0);
+	bool bTransition = (previous && _bTransitionPending && !bShared);
+	unsigned int numShown = 0;
+	if (bTransition) {
+		float t;
+		_pTransition->get(t);
+		numShown = std::min(previous->size(), vertices->size());
+		for (unsigned int i=0; i < numShown; i++)
+			(*previous)[i] += ((*vertices)[i] - (*previous)[i]) * t;
+	}
+	_bTransitionPending = false;
+
+	// Views sharing the bars of a dataset draw none of their own
+	if (bShared) {
+		updateSharedBars();
+		vertices->clear();
+		static_cast<osg::Vec4Array*>( _pBars->getColorArray() )->clear();
+		_pBarIndices->clear();
+		_pBarIndices->dirty();
+	}
+	else {
+		fillBars(_pBars.get(), _layoutDim);
+	}
+	if (_pSharedGeode.valid())
+		_pSharedGeode->setNodeMask(bShared ? ~0u : 0u);
+
+	if (previous) {
+		// New bars grow from their base; otherwise the bars jump
+		previous->resize(vertices->size());
+		for (unsigned int i=numShown; i < vertices->size(); i++) {
+			if (bTransition)
+				(*previous)[i].set((*vertices)[i].x(), (*vertices)[i - i % 4].y(), 0);
+			else
+				(*previous)[i] = (*vertices)[i];
+		}
+		previous->dirty();
+
+		if (bTransition) {
+			_pTransition->set(0.0f);
+			_pTransitionCallback->restart();
+		}
 	}
 
+	// The overlay follows the bars, smoothed again only if they changed
+	updateDensity();
+	osg::Vec3Array* densityVertices = static_cast<osg::Vec3Array*>( _pDensity->getVertexArray() );
+	densityVertices->resize(_density.size());
+	for (int i=0; i < _density.size(); i++) {
+		float x, y;
+		computeDensityPoint(i, _layoutDim, x, y);
+		(*densityVertices)[i].set(x, y, 0);
+	}
+	densityVertices->dirty();
+	static_cast<osg::DrawArrays*>( _pDensity->getPrimitiveSet(0) )->setCount(_density.size());
+	_pDensity->getPrimitiveSet(0)->dirty();
+	_pDensity->dirtyBound();
+
+	_pBars->dirtyBound();
 	_pGeode->dirtyBound();
+	dirtyRedraw();
+}
+
+void osgtools::Histogram::fillBars( osg::Geometry* pBars, const int* dim )
+{
+	osg::Vec3Array* vertices = static_cast<osg::Vec3Array*>( pBars->getVertexArray() );
+	osg::Vec4Array* colors = static_cast<osg::Vec4Array*>( pBars->getColorArray() );
+	osg::DrawElementsUInt* indices = static_cast<osg::DrawElementsUInt*>( pBars->getPrimitiveSet(0) );
+
+	int numBars = 0;
+	for (int s=0; s < _series.size(); s++)
+		numBars += _series[s].bins.size();
+
+	// Resize in place; the arrays keep their storage when shrinking
+	vertices->resize(numBars * 4);
+	colors->resize(numBars * 4);
+	if (indices->size() != numBars * 6) {
+		unsigned int numIndexed = indices->size() / 6;
+		indices->resize(numBars * 6);
+		for (unsigned int i=numIndexed; i < numBars; i++) {
+			(*indices)[i*6 + 0] = i*4 + 0;
+			(*indices)[i*6 + 1] = i*4 + 1;
+			(*indices)[i*6 + 2] = i*4 + 2;
+			(*indices)[i*6 + 3] = i*4 + 0;
+			(*indices)[i*6 + 4] = i*4 + 2;
+			(*indices)[i*6 + 5] = i*4 + 3;
+		}
+		indices->dirty();
+	}
+
+	//Construct the rectangles of all series
+	int v = 0;
+	for (int s=0; s < _series.size(); s++) {
+		const Series& series = _series[s];
+		for (int i=0; i < series.bins.size(); i++, v += 4) {
+			float startx, starty, endx, endy;
+			if (dim)
+				computeBar(s, i, dim, startx, starty, endx, endy);
+			else
+				getBarExtent(s, i, startx, starty, endx, endy);
+
+			(*vertices)[v + 0].set( startx, starty, 0);
+			(*vertices)[v + 1].set( endx, starty, 0);
+			(*vertices)[v + 2].set( endx, endy, 0);
+			(*vertices)[v + 3].set( startx, endy, 0);
+
+			(*colors)[v + 0] = series.lightColor;
+			(*colors)[v + 1] = series.darkColor;
+			(*colors)[v + 2] = series.darkColor;
+			(*colors)[v + 3] = series.lightColor;
+		}
+	}
+	vertices->dirty();
+	colors->dirty();
+	pBars->dirtyBound();
+}
+
+void osgtools::Histogram::getBarExtent( int series, int i, float& left, float& bottom, float& right, float& top ) const
+{
+	bottom = 0;
+	top = _series[series].bins[i];
+
+	// Bins with edges span them, with the same gap in scale space
+	const AxisScale* pScale = _scales[0].get();
+	bool bEdges = (i + 1 < _binEdges.size());
+	double center = i, halfWidth = .45;
+	if (bEdges) {
+		double edge0 = pScale->forward(_binEdges[i]);
+		double edge1 = pScale->forward(_binEdges[i + 1]);
+		center = (edge0 + edge1) / 2;
+		halfWidth = (edge1 - edge0) * .45;
+	}
+
+	if (_seriesMode == GROUPED) {
+		// Split the bin between the series
+		double width = 2 * halfWidth / _series.size();
+		double start = center - halfWidth + series * width;
+		left = (bEdges ? pScale->inverse(start) : start);
+		right = (bEdges ? pScale->inverse(start + width) : start + width);
+	}
+	else {
+		left = (bEdges ? pScale->inverse(center - halfWidth) : center - halfWidth);
+		right = (bEdges ? pScale->inverse(center + halfWidth) : center + halfWidth);
+	}
+
+	if (_seriesMode == STACKED) {
+		// Start on top of the previous series
+		for (int s=0; s < series; s++) {
+			if (i < _series[s].bins.size())
+				bottom += _series[s].bins[i];
+		}
+		top += bottom;
+	}
+}
+
+float osgtools::Histogram::getBinCenter( int i ) const
+{
+	if (i + 1 >= _binEdges.size())
+		return i;
+
+	// Halfway between the edges in scale space
+	const AxisScale* pScale = _scales[0].get();
+	return pScale->inverse((pScale->forward(_binEdges[i]) + pScale->forward(_binEdges[i + 1])) / 2);
+}
+
+void osgtools::Histogram::computeDensityPoint( int i, const int* dim, float& x, float& y ) const
+{
+	x = getValuePixel(0, std::min(std::max(getBinCenter(i), _range[0]), _range[2]), dim);
+	y = getValuePixel(1, std::min(std::max(_density[i], _range[1]), _range[3]), dim);
+}
+
+void osgtools::Histogram::computeBar( int series, int i, const int* dim, float& startx, float& starty, float& endx, float& endy ) const
+{
+	float left, bottom, right, top;
+	getBarExtent(series, i, left, bottom, right, top);
+
+	// Clamp to the range, so bars below a log axis stay flat
+	startx = getValuePixel(0, std::min(std::max(left, _range[0]), _range[2]), dim);
+	endx = getValuePixel(0, std::min(std::max(right, _range[0]), _range[2]), dim);
+	starty = getValuePixel(1, std::min(std::max(bottom, _range[1]), _range[3]), dim);
+	endy = getValuePixel(1, std::min(std::max(top, _range[1]), _range[3]), dim);
+}
+
+void osgtools::Histogram::drawVectorData( VectorCanvas& canvas )
+{
+	for (int s=0; s < _series.size(); s++) {
+		for (int i=0; i < _series[s].bins.size(); i++) {
+			float startx, starty, endx, endy;
+			computeBar(s, i, _plotDim, startx, starty, endx, endy);
+			canvas.rect(startx, starty, endx, endy, _series[s].lightColor, _series[s].darkColor);
+		}
+	}
+
+	// The density overlay over the bars
+	updateDensity();
+	for (int i=1; i < _density.size(); i++) {
+		float x0, y0, x1, y1;
+		computeDensityPoint(i - 1, _plotDim, x0, y0);
+		computeDensityPoint(i, _plotDim, x1, y1);
+		canvas.line(x0, y0, x1, y1, DENSITY_WIDTH, _densityColor);
+	}
 }
 
 void osgtools::Histogram::autoUpdateMajorMinorAxes()
 {
-	if (_bins.size() <= 0)
+	int numBins = getNumBins();
+	if (numBins <= 0)
 		return;
 
-	// Get the max element
-	float maxval = _bins[0];
-	for (int i=1; i < _bins.size(); i++) {
-		if (maxval < _bins[i])
-			maxval = _bins[i];
+	// Get the extent of the bars
+	float xmin, ymin, xmax, ymax;
+	getDataRange(xmin, ymin, xmax, ymax);
+
+	// Nice steps, whole bins along x unless the bins have edges
+	float xGrid = getNiceGrid(0, xmin, xmax);
+	float yGrid = getNiceGrid(1, ymin, ymax);
+	setMajorAxisGrid( (_binEdges.empty() ? std::max(xGrid, 1.0f) : xGrid), yGrid );
+	setMinorAxisGrid( 0, Ticks::getMinorStep(yGrid) );
+}
+
+int osgtools::Histogram::getBin( float x ) const
+{
+	// Search the edges, or round to the nearest center
+	if (_binEdges.size() > 1) {
+		int i = std::upper_bound(_binEdges.begin(), _binEdges.end(), x) - _binEdges.begin() - 1;
+		return (i < 0 || i + 1 >= _binEdges.size() ? -1 : i);
 	}
+	int i = (int)floor(x + 0.5);
+	return (i < 0 || i >= getNumBins() ? -1 : i);
+}
+
+bool osgtools::Histogram::pick( float x, float y, PlotPick& pick )
+{
+	int bin = getBin(getXPixelValue(x));
+	if (bin < 0 || x < _plotDim[0] || x > _plotDim[0] + _plotDim[2] || y < _plotDim[1] || y > _plotDim[1] + _plotDim[3])
+		return false;
 
-	setMajorAxisGrid( _bins.size()/ 6, maxval / 6 );
-	setMinorAxisGrid( 0, maxval / 12 );
+	// Prefer the bar under the cursor, the front one when overlaid
+	float valueX = getXPixelValue(x);
+	float valueY = getYPixelValue(y);
+	int hit = -1;
+	for (int s=_series.size() - 1; s >= 0; s--) {
+		if (bin >= _series[s].bins.size())
+			continue;
+		float left, bottom, right, top;
+		getBarExtent(s, bin, left, bottom, right, top);
+		if (valueX < left || valueX > right)
+			continue;
+		if (hit < 0)
+			hit = s;
+		if (valueY >= std::min(bottom, top) && valueY <= std::max(bottom, top)) {
+			hit = s;
+			break;
+		}
+	}
+	if (hit < 0)
+		return false;
+
+	pick.series = hit;
+	pick.index = bin;
+	pick.row = -1;
+	pick.x = (_binEdges.size() > 1 ? _binEdges[bin] : bin);
+	pick.y = valueY;
+	pick.value = _series[hit].bins[bin];
+	return true;
+}
+
+std::string osgtools::Histogram::getPickText( const PlotPick& pick )
+{
+	char s[64];
+	if (_binEdges.size() > 1)
+		snprintf(s, sizeof(s), "[%g, %g): %g", _binEdges[pick.index], _binEdges[pick.index + 1], pick.value);
+	else
+		snprintf(s, sizeof(s), "Bin %d: %g", pick.index, pick.value);
+	if (_series.size() > 1) {
+		char prefix[32];
+		snprintf(prefix, sizeof(prefix), "Series %d, ", pick.series);
+		return std::string(prefix) + s;
+	}
+	return s;
 }
\ No newline at end of file
@@ -11,36 +11,462 @@
 // OSG
 #include <osg/Geode>
 #include <osg/Geometry>
+#include <osg/Uniform>
 
 // STL
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 // Local
 #include "osgtools.h"
 #include "plot.h"
+#include "quantilesketch.h"
 
 namespace osgtools {
+
+	class Dataset;
+
+	/*!
+	 *	The bins of a histogram series: either a float copy, or a view of the
+	 *	caller's array of any arithmetic type, read in place.
+	 */
+	class OSGTOOLS HistogramBins {
+		std::vector<float> _copy;
+		const void* _pData;								/*!< The caller's bins, null for a copy */
+		int _size;
+		float (*_pRead)( const void* pData, int i );	/*!< Reads bin i of the caller's type */
+
+		template<typename T>
+		static float read( const void* pData, int i ) { return (float)static_cast<const T*>(pData)[i]; }
+
+	public:
+		HistogramBins() : _pData(0), _size(0), _pRead(0) {}
+
+		/*!
+		 *	Copies the bins, converting to float. The storage is kept, so
+		 *	copying no more bins than before does not allocate.
+		 */
+		template<typename T>
+		void copy( const T* bins, int numBins ) {
+			static_assert(std::is_arithmetic<T>::value, "bins must be of an arithmetic type");
+			_copy.assign(bins, bins + numBins);
+			_pData = 0;
+			_pRead = 0;
+			_size = numBins;
+		}
+
+		/*!
+		 *	Reads the bins in place. The caller keeps them alive while they
+		 *	are shown.
+		 */
+		template<typename T>
+		void view( const T* bins, int numBins ) {
+			static_assert(std::is_arithmetic<T>::value, "bins must be of an arithmetic type");
+			_pData = bins;
+			_pRead = &read<T>;
+			_size = numBins;
+		}
+
+		int size() const { return _size; }
+		float operator[]( int i ) const { return _pRead ? _pRead(_pData, i) : _copy[i]; }
+	};
 	
+	/*!
+	 *	Bar plot of one or more series of bins. All series share the plot
+	 *	layout and are drawn as one geometry, so a series costs only the
+	 *	vertices of its bars.
+	 */
 	class OSGTOOLS Histogram : public Plot {
+	public:
+		/*!
+		 *	How the bars of several series share a bin
+		 */
+		enum SeriesMode {
+			GROUPED,	/*!< Side by side */
+			STACKED,	/*!< On top of each other */
+			OVERLAID	/*!< In front of each other, the last series in front */
+		};
+
 	protected:
-		std::vector<float> _bins;
+		struct Series {
+			HistogramBins bins;
+			osg::Vec4 lightColor;
+			osg::Vec4 darkColor;
+		};
+		std::vector<Series> _series;
+		std::vector<float> _binEdges;				/*!< x edges of the bins, empty to center bin i on x = i */
+		SeriesMode _seriesMode;
+		std::vector<float> _sketchBins;				/*!< Bins of the last sketch shown */
 		std::vector<float> xValues;
 		std::vector<float> yValues;
 
 		osg::ref_ptr<osg::Geode> _pGeode;
 		
-		std::vector<osg::ref_ptr<osg::Geometry>> _histogramGeo;
+		osg::ref_ptr<osg::Geometry> _pBars;			/*!< The bars of all series, four vertices each */
+		osg::ref_ptr<osg::DrawElementsUInt> _pBarIndices;
+
+		int _densitySeries;							/*!< Series smoothed by the density overlay, -1 for none */
+		float _densityBandwidth;					/*!< Standard deviation of the smoothing kernel in bins */
+		bool _bDensityDirty;						/*!< The bins changed since the overlay was smoothed */
+		std::vector<float> _density;				/*!< Smoothed bins of the overlay */
+		std::vector<float> _densityScratch;
+		osg::Vec4 _densityColor;
+		osg::ref_ptr<osg::Geometry> _pDensity;		/*!< The overlay, one line strip */
+
+		double _transitionDuration;					/*!< Seconds to animate a change of the bins, 0 for none */
+		bool _bTransitionPending;					/*!< The bins changed; the next redraw starts a transition */
+		class TransitionCallback;
+		osg::ref_ptr<TransitionCallback> _pTransitionCallback;
+		osg::ref_ptr<osg::Uniform> _pTransition;	/*!< Progress of the transition, 0 at the previous bars */
+
+		osg::ref_ptr<Dataset> _pDataset;			/*!< Dataset shown, null when the series are set directly */
+		osg::ref_ptr<osg::MatrixTransform> _pSharedTransform;	/*!< Maps the shared bars of the dataset onto the layout */
+		osg::ref_ptr<osg::Geode> _pSharedGeode;
+		bool _bDatasetFitted;						/*!< The range was fit to the bins of the dataset */
+		std::vector<float> _datasetBins;			/*!< Bins set on the dataset, converted to float */
+
+		// Constants
+		static const osg::Vec4 BAR_LIGHT_COLOR;
+		static const osg::Vec4 BAR_DARK_COLOR;
+		static const osg::Vec4 DENSITY_COLOR;
+		static const float DENSITY_WIDTH;
+
+		/*!
+		 *	Gets the number of bins of the longest series
+		 */
+		int getNumBins() const;
+
+		/*!
+		 *	Gets the top of the highest bar in the current mode
+		 */
+		float getMaxValue() const;
+
+		/*!
+		 *	Gets the range showing all bars. On a y axis that cannot show
+		 *	zero, such as a LogScale, the range starts below the lowest bar.
+		 */
+		void getDataRange( float& xmin, float& ymin, float& xmax, float& ymax ) const;
+
+		/*!
+		 *	Sets the range to show all bars
+		 */
+		void fitRange();
+
+		/*!
+		 *	Gets the extent of a bar in plot coordinates
+		 *	\param	series	The series
+		 *	\param	i		The bin
+		 */
+		void getBarExtent( int series, int i, float& left, float& bottom, float& right, float& top ) const;
+
+		/*!
+		 *	Gets the bin at an x value, by binary search of the edges
+		 *	\return	The bin, or -1 outside of the bins
+		 */
+		int getBin( float x ) const;
+
+		/*!
+		 *	Computes the rectangle of a bar, clamped to the range
+		 *	\param	series	The series
+		 *	\param	i		The bin
+		 *	\param	dim		The plot dimensions to map onto (_plotDim or _layoutDim)
+		 */
+		void computeBar( int series, int i, const int* dim, float& startx, float& starty, float& endx, float& endy ) const;
+
+		/*!
+		 *	Fills a bar geometry with the bars of all series, in place
+		 *	\param	pBars	The geometry, built like _pBars
+		 *	\param	dim		The plot dimensions to map onto, or 0 for plot
+		 *					coordinates
+		 */
+		void fillBars( osg::Geometry* pBars, const int* dim );
+
+		/*!
+		 *	Gets whether the bars are drawn from the shared geometry of the
+		 *	dataset, which needs linear axes
+		 */
+		bool isSharingBars() const;
+
+		/*!
+		 *	Fills the shared bars if they lag the dataset, and maps them onto
+		 *	the layout at the current range
+		 */
+		void updateSharedBars();
+
+		/*!
+		 *	Reads the series of the dataset in place
+		 */
+		void readDataset();
+
+		/*!
+		 *	Replaces all series of the dataset with _datasetBins
+		 */
+		bool setDatasetHistogram();
+
+		/*!
+		 *	Sets the colors of a series, shaded darker to the right
+		 */
+		void shadeSeries( int series, const osg::Vec4& color );
+
+		/*!
+		 *	Gets the center of a bin in plot coordinates
+		 */
+		float getBinCenter( int i ) const;
+
+		/*!
+		 *	Smooths the bins of the overlay series, if they changed
+		 */
+		void updateDensity();
+
+		/*!
+		 *	Averages each value with its neighbours within a radius, treating
+		 *	values past the ends as zero. Costs O(n) for any radius.
+		 */
+		static void boxBlur( const float* in, float* out, int n, int radius );
+
+		/*!
+		 *	Computes a point of the overlay, clamped to the range
+		 */
+		void computeDensityPoint( int i, const int* dim, float& x, float& y ) const;
+
+		/*!
+		 *	Draws the bars of the vector output
+		 */
+		virtual void drawVectorData( VectorCanvas& canvas );
+
+		/*!
+		 *	Finishes setting the bins of the only series
+		 */
+		bool updateHistogram();
+
+		/*!
+		 *	Finishes adding the last series
+		 */
+		int updateAddedSeries( const osg::Vec4& color );
+
+		/*!
+		 *	Finishes setting the bins of a series
+		 */
+		void updateSeries();
+
+		/*!
+		 *	Adds _datasetBins to the dataset as a series
+		 */
+		int addDatasetSeries( const osg::Vec4& color );
+
+		/*!
+		 *	Replaces the bins of a series of the dataset with _datasetBins
+		 */
+		bool setDatasetSeries( int series );
+
 	public:
-		Histogram() {}
+		Histogram();
 		Histogram( int width, int height );
+		virtual ~Histogram();
 				
+		/*!
+		 *	Shows a single series of bins, replacing all series
+		 */
 		bool setHistogram( std::vector<float>& bins );
+
+		/*!
+		 *	Shows a single series of bins of any arithmetic type, replacing
+		 *	all series
+		 *	\param	bins	The bins
+		 *	\param	numBins	The number of bins
+		 *	\param	bCopy	False to read the bins in place instead of copying
+		 *					them. The caller then keeps the bins alive while
+		 *					they are shown, and calls setHistogram again after
+		 *					changing them.
+		 *	\return	True if there are bins
+		 */
+		template<typename T>
+		bool setHistogram( const T* bins, int numBins, bool bCopy = true ) {
+			if (!bins || numBins <= 0)
+				return false;
+			if (_pDataset.valid()) {
+				_datasetBins.assign(bins, bins + numBins);
+				return setDatasetHistogram();
+			}
+
+			_series.resize(1);
+			if (bCopy)
+				_series[0].bins.copy(bins, numBins);
+			else
+				_series[0].bins.view(bins, numBins);
+			return updateHistogram();
+		}
+
+		/*!
+		 *	Sets the x edges of the bins, so bin i spans edges[i] to
+		 *	edges[i + 1]. Use AxisScale::getBinEdges with a LogScale on the
+		 *	x axis for log binning.
+		 *	\param	edges	Increasing edges, one more than the bins, or empty
+		 *					to center bin i on x = i
+		 *	\return	True if the edges are increasing
+		 */
+		bool setBinEdges( std::vector<float>& edges );
+
+		/*!
+		 *	Shows a sketch rebinned into the current x range, replacing all
+		 *	series. Bins have equal width in the scale of the x axis, so a
+		 *	LogScale gives log bins. Call again after changing the range or
+		 *	the sketch.
+		 *	\param	sketch	The sketch
+		 *	\param	numBins	The number of bins
+		 *	\return	True if there are bins
+		 */
+		bool setSketch( const QuantileSketch& sketch, int numBins );
+
+		/*!
+		 *	Adds a series of bins
+		 *	\param	bins	The bins
+		 *	\param	color	The color of the bars, shaded darker to the right
+		 *	\return	The index of the series
+		 */
+		int addSeries( std::vector<float>& bins, const osg::Vec4& color );
+
+		/*!
+		 *	Adds a series of bins of any arithmetic type
+		 *	\param	bins	The bins
+		 *	\param	numBins	The number of bins
+		 *	\param	color	The color of the bars, shaded darker to the right
+		 *	\param	bCopy	False to read the bins in place, as for setHistogram
+		 *	\return	The index of the series, which is empty if there are no bins
+		 */
+		template<typename T>
+		int addSeries( const T* bins, int numBins, const osg::Vec4& color, bool bCopy = true ) {
+			if (!bins || numBins <= 0) {
+				bins = 0;
+				numBins = 0;
+			}
+			if (_pDataset.valid()) {
+				_datasetBins.assign(bins, bins + numBins);
+				return addDatasetSeries(color);
+			}
+
+			_series.push_back(Series());
+			if (bCopy)
+				_series.back().bins.copy(bins, numBins);
+			else
+				_series.back().bins.view(bins, numBins);
+			return updateAddedSeries(color);
+		}
+
+		/*!
+		 *	Replaces the bins of a series
+		 *	\return	True if the series exists
+		 */
+		bool setSeries( int series, std::vector<float>& bins );
+
+		/*!
+		 *	Replaces the bins of a series with bins of any arithmetic type,
+		 *	clearing it if there are none
+		 *	\param	bCopy	False to read the bins in place, as for setHistogram
+		 *	\return	True if the series exists
+		 */
+		template<typename T>
+		bool setSeries( int series, const T* bins, int numBins, bool bCopy = true ) {
+			if (series < 0 || series >= _series.size())
+				return false;
+			if (!bins || numBins <= 0) {
+				bins = 0;
+				numBins = 0;
+			}
+			if (_pDataset.valid()) {
+				_datasetBins.assign(bins, bins + numBins);
+				return setDatasetSeries(series);
+			}
+
+			if (bCopy)
+				_series[series].bins.copy(bins, numBins);
+			else
+				_series[series].bins.view(bins, numBins);
+			updateSeries();
+			return true;
+		}
+
+		/*!
+		 *	Shows the series of a dataset, replacing all series. The views
+		 *	of a dataset read its bins in place and, on linear axes, draw
+		 *	its single bar geometry through their own range transform, so a
+		 *	change of the dataset is uploaded once however many views show
+		 *	it. The bins, bin edges, series mode and colors then belong to
+		 *	the dataset; setting them here sets them on the dataset, copying
+		 *	the bins. The range is fit to the bins when the view attaches,
+		 *	and after that is kept, so a view stays zoomed as the data changes.
+		 *	\param	pDataset	The dataset, or 0 to stop showing it
+		 */
+		void setDataset( Dataset* pDataset );
+
+		Dataset* getDataset() { return _pDataset.get(); }
+
+		/*!
+		 *	Shows the current series of the dataset. Called by the dataset
+		 *	when it changes.
+		 */
+		void updateDataset();
+
+		/*!
+		 *	Sets the color of a series
+		 */
+		void setSeriesColor( int series, const osg::Vec4& color );
+
+		/*!
+		 *	Removes all series
+		 */
+		void clearSeries();
+
+		int getNumSeries() { return _series.size(); }
+
+		/*!
+		 *	Sets how the series share a bin
+		 */
+		void setSeriesMode( SeriesMode mode );
+		SeriesMode getSeriesMode() { return _seriesMode; }
+		
+		/*!
+		 *	Overlays a smoothed density curve on the bars of a series. The
+		 *	bins are smoothed with three running box passes approximating a
+		 *	Gaussian kernel, in O(bins) for any bandwidth, and only again
+		 *	when the bins change.
+		 *	\param	series		The series to smooth, or -1 to hide the overlay
+		 *	\param	bandwidth	The standard deviation of the kernel in bins
+		 */
+		void setDensityOverlay( int series, float bandwidth );
+
+		/*!
+		 *	Sets the color of the density overlay
+		 */
+		void setDensityColor( const osg::Vec4& color );
+		
+		/*!
+		 *	Animates the bars when the bins change. The bars as shown and the
+		 *	new bars are uploaded once as two vertex attributes and blended in
+		 *	the vertex shader, so a frame of the animation only updates a
+		 *	uniform. Changes of the range end a running transition.
+		 *	\param	seconds	The duration of a transition, or 0 to jump
+		 */
+		void setTransitionDuration( double seconds );
+		double getTransitionDuration() { return _transitionDuration; }
 		
 		/*!
 		 *	Redraw function for subclasses
 		 */
 		virtual void redraw();
 
+		/*!
+		 *	Finds the bar at a pixel: the bar under the cursor, or the first
+		 *	one in the column of the cursor. The index is the bin.
+		 */
+		virtual bool pick( float x, float y, PlotPick& pick );
+
+		/*!
+		 *	Formats the bin and value of a pick
+		 */
+		virtual std::string getPickText( const PlotPick& pick );
+
 		/*!
 		 *	Automatically update data labels
 		 */
@@ -0,0 +1,85 @@
+/*
+	histogramfeed.cpp
+	Feeds a histogram from a shared memory producer
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "histogramfeed.h"
+
+#include <algorithm>
+
+osgtools::HistogramFeed::HistogramFeed( int series ) :
+	_pFeed(0),
+	_maxBins(0),
+	_series(series),
+	_lastFrame(0)
+{
+}
+
+osgtools::HistogramFeed::~HistogramFeed()
+{
+	close();
+}
+
+bool osgtools::HistogramFeed::open( const std::string& name )
+{
+	close();
+	_pFeed = osgtools_feed_open(name.c_str(), &_maxBins);
+	if (!_pFeed)
+		return false;
+
+	_lastFrame = 0;
+	return true;
+}
+
+void osgtools::HistogramFeed::close()
+{
+	if (!_pFeed)
+		return;
+
+	// The histogram keeps its bins once the shared memory is gone
+	osg::ref_ptr<Histogram> pHistogram;
+	if (_histogram.lock(pHistogram) && _lastFrame > 0)
+		setBins(pHistogram.get(), osgtools_feed_get_slot(_pFeed, _maxBins, _pFeed->consumerSlot), true);
+	_histogram = 0;
+
+	osgtools_feed_close(_pFeed, _maxBins);
+	_pFeed = 0;
+	_maxBins = 0;
+}
+
+bool osgtools::HistogramFeed::hasFrame()
+{
+	return _pFeed && (__atomic_load_n(&_pFeed->middle, __ATOMIC_RELAXED) & OSGTOOLS_FEED_FRESH);
+}
+
+void osgtools::HistogramFeed::operator()( osg::Node* pNode, osg::NodeVisitor* pNv )
+{
+	Histogram* pHistogram = dynamic_cast<Histogram*>(pNode);
+	osgtools_feed_slot* pSlot = pHistogram && _pFeed ? osgtools_feed_take(_pFeed, _maxBins) : 0;
+
+	// Read in place; the slot is ours until the next take, and the
+	// previous one is no longer read once the bins are replaced
+	if (pSlot && setBins(pHistogram, pSlot, false)) {
+		_histogram = pHistogram;
+		_lastFrame = pSlot->frame;
+	}
+
+	traverse(pNode, pNv);
+}
+
+bool osgtools::HistogramFeed::setBins( Histogram* pHistogram, osgtools_feed_slot* pSlot, bool bCopy )
+{
+	// The producer writes numBins, so it is bounded by the slots as mapped
+	const float* bins = osgtools_feed_get_bins(pSlot);
+	int numBins = (int)std::min(pSlot->numBins, _maxBins);
+	if (_series >= 0)
+		return pHistogram->setSeries(_series, bins, numBins, bCopy);
+
+	if (numBins > 0)
+		return pHistogram->setHistogram(bins, numBins, bCopy);
+	pHistogram->clearSeries();
+	return true;
+}
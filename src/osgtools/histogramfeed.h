@@ -0,0 +1,92 @@
+/*
+	histogramfeed.h
+	Feeds a histogram from a shared memory producer
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <string>
+
+// OSG
+#include <osg/NodeCallback>
+#include <osg/observer_ptr>
+
+// Local
+#include "osgtools.h"
+#include "histogram.h"
+#include "shmfeed.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Update callback showing the newest frame of a shared memory feed
+	 *	(shmfeed.h) on a Histogram. The histogram reads the bins in place
+	 *	from the shared memory, so a frame is never parsed or copied. Set it
+	 *	as the update callback of the histogram:
+	 *
+	 *		osg::ref_ptr<HistogramFeed> pFeed = new HistogramFeed();
+	 *		if (pFeed->open("/daq"))
+	 *			pHistogram->setUpdateCallback(pFeed.get());
+	 *
+	 *	When running on demand, request a redraw while hasFrame() is true.
+	 */
+	class OSGTOOLS HistogramFeed : public osg::NodeCallback {
+	protected:
+		osgtools_feed_header* _pFeed;
+		uint32_t _maxBins;							/*!< Bins of each slot, as mapped on open */
+		int _series;								/*!< Series fed, or -1 for the only one */
+		uint64_t _lastFrame;						/*!< Number of the shown frame */
+		osg::observer_ptr<Histogram> _histogram;	/*!< Histogram reading the shared memory */
+
+		virtual ~HistogramFeed();
+
+		/*!
+		 *	Sets the bins of a slot on the histogram, at most _maxBins of them
+		 *	\param	pHistogram	The histogram
+		 *	\param	pSlot		The consumer's slot
+		 *	\param	bCopy		False to read the bins in place
+		 *	\return	False if the fed series does not exist
+		 */
+		bool setBins( Histogram* pHistogram, osgtools_feed_slot* pSlot, bool bCopy );
+
+	public:
+		/*!
+		 *	Creates the feed
+		 *	\param	series	The series to feed, or -1 to replace all series
+		 */
+		HistogramFeed( int series = -1 );
+
+		/*!
+		 *	Attaches to a feed created by a producer
+		 *	\param	name	The shared memory name, starting with '/'
+		 *	\return	True if the feed exists
+		 */
+		bool open( const std::string& name );
+
+		/*!
+		 *	Detaches from the feed. The histogram keeps a copy of the shown
+		 *	frame.
+		 */
+		void close();
+
+		bool isOpen() { return _pFeed != 0; }
+
+		/*!
+		 *	Gets whether a frame was published since the last one shown
+		 */
+		bool hasFrame();
+
+		/*!
+		 *	Gets the number of the shown frame, 0 before the first
+		 */
+		uint64_t getLastFrame() { return _lastFrame; }
+
+		/*!
+		 *	Shows the newest frame, if there is one
+		 */
+		virtual void operator()( osg::Node* pNode, osg::NodeVisitor* pNv );
+	};
+}
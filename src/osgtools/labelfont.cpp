@@ -0,0 +1,102 @@
+/*
+	labelfont.cpp
+	Shared distance field font of plot and widget labels
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "labelfont.h"
+
+#include <osg/Texture>
+#include <osg/Version>
+
+// Constants
+const char* osgtools::LabelFont::FONT_FILE = "/fonts/arial.ttf";
+const unsigned int osgtools::LabelFont::GLYPH_RESOLUTION = 32;
+const unsigned int osgtools::LabelFont::ATLAS_SIZE = 1024;
+const char* osgtools::LabelFont::NUMBER_CHARACTERS = "0123456789.,-+eE%x ";
+const float osgtools::LabelFont::DEFAULT_ADVANCE = 0.6;
+
+osgtools::LabelFont::Advances::Advances()
+{
+	osgText::Font* pFont = getFont();
+	osgText::FontResolution resolution(GLYPH_RESOLUTION, GLYPH_RESOLUTION);
+	for (int c=0; c < 128; c++) {
+		advance[c] = DEFAULT_ADVANCE;
+		if (c < 32 || c == 127)
+			continue;
+
+		// Glyph advances are normalized to a character size of one
+		osgText::Glyph* pGlyph = pFont->getGlyph(resolution, c);
+		if (pGlyph)
+			advance[c] = pGlyph->getHorizontalAdvance();
+	}
+}
+
+osgText::Font* osgtools::LabelFont::getFont()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osgText::Font> pFont = createFont();
+	return pFont.get();
+}
+
+osgText::Font* osgtools::LabelFont::createFont()
+{
+	osg::ref_ptr<osgText::Font> pFont = osgText::readRefFontFile(FONT_FILE);
+	if (!pFont.valid())
+		pFont = osgText::Font::getDefaultFont();
+
+	// One atlas, sampled smoothly so the distance field scales
+	pFont->setTextureSizeHint(ATLAS_SIZE, ATLAS_SIZE);
+	pFont->setMinFilterHint(osg::Texture::LINEAR);
+	pFont->setMagFilterHint(osg::Texture::LINEAR);
+
+	// Laid out with the font directly, as getFont is not set yet
+	prewarm(pFont.get(), NUMBER_CHARACTERS);
+	return pFont.release();
+}
+
+void osgtools::LabelFont::setupText( osgText::Text* pText )
+{
+	setupText(pText, getFont());
+}
+
+void osgtools::LabelFont::setupText( osgText::Text* pText, osgText::Font* pFont )
+{
+	if (!pText)
+		return;
+
+	// Glyphs at one resolution serve every character size
+	pText->setFont(pFont);
+	pText->setFontResolution(GLYPH_RESOLUTION, GLYPH_RESOLUTION);
+#if OSG_VERSION_GREATER_OR_EQUAL(3,6,0)
+	pText->setShaderTechnique(osgText::SIGNED_DISTANCE_FIELD);
+#endif
+}
+
+void osgtools::LabelFont::prewarm( const std::string& characters )
+{
+	prewarm(getFont(), characters);
+}
+
+void osgtools::LabelFont::prewarm( osgText::Font* pFont, const std::string& characters )
+{
+	// Laying out a text generates its glyphs and places them in the atlas
+	osg::ref_ptr<osgText::Text> pText = new osgText::Text();
+	setupText(pText.get(), pFont);
+	pText->setText(characters);
+}
+
+float osgtools::LabelFont::getTextWidth( const std::string& text, float size )
+{
+	// Read once, on whichever thread first measures
+	static const Advances advances;
+
+	float width = 0;
+	for (int i=0; i < text.size(); i++) {
+		unsigned char c = text[i];
+		width += (c < 128 ? advances.advance[c] : DEFAULT_ADVANCE);
+	}
+	return width * size;
+}
@@ -0,0 +1,93 @@
+/*
+	labelfont.h
+	Shared distance field font of plot and widget labels
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <string>
+
+// OSG
+#include <osgText/Font>
+#include <osgText/Text>
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	The font shared by all labels. On OSG 3.6 and later the glyphs are
+	 *	rendered once, as signed distance fields at a fixed resolution, into
+	 *	a single atlas and drawn with the distance field shader of osgText.
+	 *	Labels stay sharp at any size and rotation, and new character
+	 *	sizes, resizes and high DPI output reuse the glyphs already made.
+	 *	Older versions of OSG draw the same glyphs in greyscale.
+	 */
+	class OSGTOOLS LabelFont {
+	public:
+		/*!
+		 *	Gets the shared font, generating the glyphs of numbers on the
+		 *	first call. Safe to call from several threads.
+		 */
+		static osgText::Font* getFont();
+
+		/*!
+		 *	Sets a text to draw with the shared font
+		 */
+		static void setupText( osgText::Text* pText );
+
+		/*!
+		 *	Generates the glyphs of characters ahead of drawing, so that
+		 *	labels using them generate nothing later, e.g. the letters of
+		 *	axis titles before the first frame
+		 *	\param	characters	The characters to generate
+		 */
+		static void prewarm( const std::string& characters );
+
+		/*!
+		 *	Measures the width of a text from the horizontal advances of
+		 *	the glyphs. The advances of printable ASCII characters are read
+		 *	from the font once and cached; other characters are estimated.
+		 *	Safe to call from several threads.
+		 *	\param	text	The text to measure
+		 *	\param	size	The character size in pixels
+		 *	\return	The width of the text in pixels
+		 */
+		static float getTextWidth( const std::string& text, float size );
+
+		// Constants
+		static const char* FONT_FILE;
+		static const unsigned int GLYPH_RESOLUTION;		/*!< Pixels of a glyph in the atlas, for every character size */
+		static const unsigned int ATLAS_SIZE;
+		static const char* NUMBER_CHARACTERS;			/*!< Characters of tick labels, generated with the font */
+		static const float DEFAULT_ADVANCE;				/*!< Advance of characters missing from the font, per pixel of size */
+
+	protected:
+		/*!
+		 *	Loads the font and generates the glyphs of numbers
+		 */
+		static osgText::Font* createFont();
+
+		/*!
+		 *	Sets a text to draw with a font
+		 */
+		static void setupText( osgText::Text* pText, osgText::Font* pFont );
+
+		/*!
+		 *	Generates the glyphs of characters in a font
+		 */
+		static void prewarm( osgText::Font* pFont, const std::string& characters );
+
+		/*!
+		 *	Advances of the printable ASCII characters per pixel of size
+		 */
+		struct Advances {
+			float advance[128];
+			Advances();
+		};
+	};
+}
@@ -0,0 +1,196 @@
+/*
+	offscreenrenderer.cpp
+	Renders plots to image files without a window
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "offscreenrenderer.h"
+#include "shaders.h"
+
+#include <cstring>
+
+#include <osg/BufferObject>
+#include <osg/GLExtensions>
+#include <osg/GraphicsContext>
+#include <osgDB/WriteFile>
+
+/*!
+ *	Reads the frame into one of two pixel buffer objects and writes the
+ *	image read on the previous frame from the other
+ */
+class osgtools::OffscreenRenderer::ReadbackCallback : public osg::Camera::DrawCallback {
+	int _width;
+	int _height;
+
+	mutable bool _bInitialized;
+	mutable GLuint _pbo[2];
+	mutable int _current;
+	mutable std::string _pending[2];		/*!< File waiting in each buffer */
+	mutable osg::ref_ptr<osg::Image> _image;
+
+public:
+	mutable std::string request;			/*!< File to read the next frame into */
+	mutable int numWritten;
+	mutable int numFailed;
+
+	ReadbackCallback( int width, int height ) :
+		_width(width),
+		_height(height),
+		_bInitialized(false),
+		_current(0),
+		numWritten(0),
+		numFailed(0)
+	{
+		_pbo[0] = _pbo[1] = 0;
+		_image = new osg::Image();
+		_image->allocateImage(_width, _height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+	}
+
+	bool isPending() const { return !_pending[0].empty() || !_pending[1].empty(); }
+
+	virtual void operator()( osg::RenderInfo& renderInfo ) const
+	{
+		osg::GLExtensions* ext = osg::GLExtensions::Get(renderInfo.getState()->getContextID(), true);
+		unsigned int size = _image->getTotalSizeInBytes();
+
+		// Create the buffers
+		if (!_bInitialized) {
+			ext->glGenBuffers(2, _pbo);
+			for (int i=0; i < 2; i++) {
+				ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, _pbo[i]);
+				ext->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, size, 0, GL_STREAM_READ_ARB);
+			}
+			_bInitialized = true;
+		}
+
+		// Start reading this frame
+		int previous = 1 - _current;
+		if (!request.empty()) {
+			ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, _pbo[_current]);
+			glReadPixels(0, 0, _width, _height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+			_pending[_current] = request;
+			request.clear();
+		}
+
+		// Write the previous frame while this one is read
+		if (!_pending[previous].empty()) {
+			ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, _pbo[previous]);
+			void* pSrc = ext->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+			if (pSrc) {
+				memcpy(_image->data(), pSrc, size);
+				ext->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+				if (osgDB::writeImageFile(*_image, _pending[previous]))
+					numWritten++;
+				else
+					numFailed++;
+			}
+			else
+				numFailed++;
+			_pending[previous].clear();
+		}
+
+		ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+		_current = previous;
+	}
+};
+
+osgtools::OffscreenRenderer::OffscreenRenderer( int width, int height ) :
+	_width(width),
+	_height(height)
+{
+	// Create the pbuffer
+	osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits();
+	traits->x = 0;
+	traits->y = 0;
+	traits->width = _width;
+	traits->height = _height;
+	traits->red = traits->green = traits->blue = traits->alpha = 8;
+	traits->depth = 24;
+	traits->doubleBuffer = false;
+	traits->pbuffer = true;
+	traits->windowDecoration = false;
+
+	osg::ref_ptr<osg::GraphicsContext> pContext = osg::GraphicsContext::createGraphicsContext(traits.get());
+	if (!pContext.valid())
+		return;
+	Shaders::setupContext(pContext.get());
+
+	// Set up the viewer
+	_root = new osg::Group();
+	_readback = new ReadbackCallback(_width, _height);
+
+	_viewer = new osgViewer::Viewer();
+	_viewer->setThreadingModel(osgViewer::Viewer::SingleThreaded);
+	_viewer->setKeyEventSetsDone(0);
+
+	osg::Camera* pCamera = _viewer->getCamera();
+	pCamera->setGraphicsContext(pContext.get());
+	pCamera->setViewport(0, 0, _width, _height);
+	pCamera->setProjectionMatrixAsOrtho2D(0, _width, 0, _height);
+	pCamera->setViewMatrix(osg::Matrix::identity());
+	pCamera->setClearColor(osg::Vec4(1.0, 1.0, 1.0, 1.0));
+	pCamera->setDrawBuffer(GL_FRONT);
+	pCamera->setReadBuffer(GL_FRONT);
+	pCamera->setFinalDrawCallback(_readback.get());
+
+	_viewer->setSceneData(_root.get());
+	_viewer->realize();
+	if (!_viewer->isRealized())
+		_viewer = 0;
+}
+
+osgtools::OffscreenRenderer::~OffscreenRenderer()
+{
+	flush();
+}
+
+bool osgtools::OffscreenRenderer::isValid()
+{
+	return _viewer.valid();
+}
+
+void osgtools::OffscreenRenderer::setClearColor( const osg::Vec4& color )
+{
+	if (_viewer.valid())
+		_viewer->getCamera()->setClearColor(color);
+}
+
+bool osgtools::OffscreenRenderer::render( Plot* pPlot, const std::string& filePath )
+{
+	if (!_viewer.valid() || !pPlot)
+		return false;
+
+	// Draw the plot at the image size
+	if (pPlot->getWidth() != _width || pPlot->getHeight() != _height)
+		pPlot->resize(_width, _height);
+	_root->removeChildren(0, _root->getNumChildren());
+	_root->addChild(pPlot);
+
+	// Render and start the readback
+	_readback->request = filePath;
+	_viewer->frame();
+	return true;
+}
+
+void osgtools::OffscreenRenderer::flush()
+{
+	if (!_viewer.valid() || !_readback->isPending())
+		return;
+
+	// Draw an empty frame to finish the readback
+	_root->removeChildren(0, _root->getNumChildren());
+	_readback->request.clear();
+	_viewer->frame();
+}
+
+int osgtools::OffscreenRenderer::getNumWritten()
+{
+	return (_readback.valid() ? _readback->numWritten : 0);
+}
+
+int osgtools::OffscreenRenderer::getNumFailed()
+{
+	return (_readback.valid() ? _readback->numFailed : 0);
+}
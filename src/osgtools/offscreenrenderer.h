@@ -0,0 +1,94 @@
+/*
+	offscreenrenderer.h
+	Renders plots to image files without a window
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <string>
+
+// OSG
+#include <osg/Camera>
+#include <osg/Group>
+#include <osg/Image>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+#include <osgViewer/Viewer>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Renders plots into a pbuffer and writes them as images. One context
+	 *	is reused for every plot, and the readback of each plot is pipelined
+	 *	through two pixel buffer objects, so the image of a plot is written
+	 *	while the next one renders. Call flush() to write the last image.
+	 *
+	 *	On machines without a GPU the pbuffer is created by Mesa (llvmpipe);
+	 *	run under Xvfb with LIBGL_ALWAYS_SOFTWARE=1 when there is no display.
+	 */
+	class OSGTOOLS OffscreenRenderer : public osg::Referenced {
+	protected:
+		int _width;				/*!< Width of the images in pixels */
+		int _height;			/*!< Height of the images in pixels */
+
+		class ReadbackCallback;
+
+		osg::ref_ptr<osgViewer::Viewer> _viewer;			/*!< Viewer driving the pbuffer */
+		osg::ref_ptr<osg::Group> _root;						/*!< Holds the plot being rendered */
+		osg::ref_ptr<ReadbackCallback> _readback;			/*!< Reads back and writes the images */
+
+		virtual ~OffscreenRenderer();
+
+	public:
+		/*!
+		 *	Creates the pbuffer context
+		 *	\param	width	The width of the images in pixels
+		 *	\param	height	The height of the images in pixels
+		 */
+		OffscreenRenderer( int width, int height );
+
+		/*!
+		 *	Gets whether the offscreen context was created
+		 */
+		bool isValid();
+
+		int getWidth() { return _width; }
+		int getHeight() { return _height; }
+
+		/*!
+		 *	Sets the background color of the images
+		 */
+		void setClearColor( const osg::Vec4& color );
+
+		/*!
+		 *	Renders a plot and queues its image to be written. The plot is
+		 *	resized to the renderer dimensions.
+		 *	\param	pPlot		The plot to render
+		 *	\param	filePath	The image file to write
+		 *	\return	True if the plot was rendered
+		 */
+		bool render( Plot* pPlot, const std::string& filePath );
+
+		/*!
+		 *	Writes the image still waiting in the readback pipeline
+		 */
+		void flush();
+
+		/*!
+		 *	Gets the number of images written
+		 */
+		int getNumWritten();
+
+		/*!
+		 *	Gets the number of images that failed to write
+		 */
+		int getNumFailed();
+	};
+}
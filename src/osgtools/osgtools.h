@@ -7,8 +7,12 @@
 */
 #pragma once
 
-#if defined(osgtools_EXPORTS)
-#   define OSGTOOLS   __declspec(dllexport)
+#if defined(_WIN32)
+#   if defined(osgtools_EXPORTS)
+#       define OSGTOOLS   __declspec(dllexport)
+#   else
+#       define OSGTOOLS   __declspec(dllimport)
+#   endif
 #else
-#   define OSGTOOLS   __declspec(dllimport)
+#   define OSGTOOLS   __attribute__((visibility("default")))
 #endif  // OSGTOOLS
@@ -0,0 +1,53 @@
+/*
+	pickhandler.cpp
+	Hover readout of plot data
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "pickhandler.h"
+
+osgtools::PickHandler::PickHandler( Plot* pPlot, TooltipWidget* pTooltip ) :
+	_plot( pPlot ),
+	_tooltip( pTooltip )
+{
+
+}
+
+bool osgtools::PickHandler::handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa )
+{
+	if (ea.getEventType() != osgGA::GUIEventAdapter::MOVE && ea.getEventType() != osgGA::GUIEventAdapter::DRAG)
+		return false;
+
+	osg::ref_ptr<Plot> pPlot;
+	osg::ref_ptr<TooltipWidget> pTooltip;
+	if (!_plot.lock(pPlot) || !_tooltip.lock(pTooltip))
+		return false;
+
+	// Mouse position in window pixels, y up
+	float x = ea.getX() - ea.getXmin();
+	float y = (ea.getMouseYOrientation() == osgGA::GUIEventAdapter::Y_INCREASING_DOWNWARDS ?
+		ea.getYmax() - ea.getY() : ea.getY() - ea.getYmin());
+
+	PlotPick pick;
+	if (!pPlot->pick(x, y, pick)) {
+		if (_lastPick.index >= 0) {
+			pTooltip->hide();
+			_lastPick = PlotPick();
+		}
+		return false;
+	}
+
+	// Only format the text when the item changed
+	if (pick.series != _lastPick.series || pick.index != _lastPick.index || pick.row != _lastPick.row || pick.value != _lastPick.value) {
+		pTooltip->setText(pPlot->getPickText(pick));
+		if (_lastPick.index < 0)
+			pTooltip->show();
+		_lastPick = pick;
+	}
+	pTooltip->moveTo(x, y);
+
+	// Let other handlers see the event
+	return false;
+}
@@ -0,0 +1,46 @@
+/*
+	pickhandler.h
+	Hover readout of plot data
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// OSG
+#include <osg/observer_ptr>
+#include <osgGA/GUIEventHandler>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+#include "tooltipwidget.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Shows the plot item under the cursor in a tooltip. Items are found
+	 *	with Plot::pick from the data, so hovering costs the same for any
+	 *	number of bars or cells. The plot must be at the origin of the
+	 *	window.
+	 */
+	class OSGTOOLS PickHandler : public osgGA::GUIEventHandler {
+	protected:
+		osg::observer_ptr<Plot> _plot;
+		osg::observer_ptr<TooltipWidget> _tooltip;
+		PlotPick _lastPick;			/*!< Item shown in the tooltip */
+
+	public:
+		/*!
+		 *	Creates the handler
+		 *	\param	pPlot		The plot to pick
+		 *	\param	pTooltip	The tooltip showing the picked item
+		 */
+		PickHandler( Plot* pPlot, TooltipWidget* pTooltip );
+
+		/*!
+		 *	Handles mouse moves
+		 */
+		virtual bool handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa );
+	};
+}
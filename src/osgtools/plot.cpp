@@ -7,8 +7,19 @@
 */
 
 #include "plot.h"
+#include "labelfont.h"
+#include "shaders.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include <osg/BlendFunc>
+#include <osg/Scissor>
 #include <osgDB/ReadFile>
+#include <osgUtil/CullVisitor>
 
 // Constants
 const int osgtools::Plot::BOTTOM_SPACING = 60;
@@ -20,20 +31,73 @@ const float osgtools::Plot::BACKGROUND_Z = -10.0;
 const float osgtools::Plot::MAJORMINORAXES_Z = -9.9;
 const float osgtools::Plot::TEXT_Z = -8.0;
 
+const osg::Vec4 osgtools::Plot::BACKGROUND_COLOR(0.898, 0.898, 0.898, 1.0);
+const osg::Vec4 osgtools::Plot::GRID_COLOR(1.0, 1.0, 1.0, 1.0);
+const osg::Vec4 osgtools::Plot::TICK_COLOR(0.0, 0.0, 0.0, 1.0);
+const osg::Vec4 osgtools::Plot::TEXT_COLOR(0.0, 0.0, 0.0, 1.0);
+
+const float osgtools::Plot::MAJOR_GRID_WIDTH = 2.0;
+const float osgtools::Plot::MINOR_GRID_WIDTH = 1.0;
+const float osgtools::Plot::TICK_WIDTH = 2.0;
+const int osgtools::Plot::TICK_LENGTH = 5;
+const int osgtools::Plot::MIN_TICK_SPACING = 2;
+const int osgtools::Plot::MAJOR_GRID_SPACING = 80;
+
+const float osgtools::Plot::TITLE_SIZE = 20.0;
+const float osgtools::Plot::TICK_LABEL_SIZE = 16.0;
+const int osgtools::Plot::LABEL_SPACING = 8;
+
+/*!
+ *	Culls the chrome camera only when the chrome changed since it was last
+ *	rendered in the culled context, so each context's cached texture is
+ *	reused on all other frames. Views and eyes sharing a context share its
+ *	texture, so the first cull renders it for all of them.
+ */
+class osgtools::Plot::ChromeCullCallback : public osg::NodeCallback {
+	Plot* _pPlot;
+public:
+	ChromeCullCallback( Plot* pPlot ) : _pPlot(pPlot) {}
+
+	virtual void operator()( osg::Node* pNode, osg::NodeVisitor* nv ) {
+		osgUtil::CullVisitor* pCv = dynamic_cast<osgUtil::CullVisitor*>(nv);
+		if (pCv && pCv->getState()) {
+			bool& bCached = _pPlot->_chromeCached[pCv->getState()->getContextID()];
+			if (bCached)
+				return;
+			bCached = true;
+		}
+		traverse(pNode, nv);
+	}
+};
+
 osgtools::Plot::Plot() :
 	_width(0),
 	_height(0),
-	_bInitialized( false )
+	_bInitialized( false ),
+	_bNeedsRedraw( true ),
+	_bChromeCaching( false ),
+	_bTile( false ),
+	_numLayouts( 0 ),
+	_bViewLayoutDirty( false )
 {
-
+	_windowOffset[0] = _windowOffset[1] = 0;
 }
 
 osgtools::Plot::Plot( int width, int height, std::string xLabel, std::string yLabel ) :
 	_width(width),
 	_height(height),
+	_bInitialized( false ),
+	_bNeedsRedraw( true ),
+	_bChromeCaching( false ),
+	_bTile( false ),
+	_numLayouts( 0 ),
+	_bViewLayoutDirty( false ),
 	_xLabel(xLabel),
 	_yLabel(yLabel)
 {
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "initialize");
+	_windowOffset[0] = _windowOffset[1] = 0;
+
 	// Set the window dimensions
 	resize( width, height );
 
@@ -49,12 +113,30 @@ void osgtools::Plot::initialize()
 	_range[2] = 10.0;
 	_range[3] = 10.0;
 
+	// Linear axes
+	_scales[0] = new LinearScale();
+	_scales[1] = new LinearScale();
+	updateScaledRange();
+
 	// Set the major axis grid
 	_majorAxisGrid[0] = _majorAxisGrid[1] = 2;
 	_minorAxisGrid[0] = _minorAxisGrid[1] = 1;
 
-	// Clear the plot dimensions
+	// Compute the plot dimensions and build the layout at them
 	memset(_plotDim,0,sizeof(int)*4);
+	updatePlotDimensions();
+	memcpy(_layoutDim,_plotDim,sizeof(int)*4);
+
+	// Create the plot area transform
+	_pPlotTransform = new osg::MatrixTransform();
+	_pPlotTransform->setDataVariance( osg::Object::DYNAMIC );
+
+	// Create the data transform, clipped to the plot area
+	_pDataTransform = new osg::MatrixTransform();
+	_pDataTransform->setDataVariance( osg::Object::DYNAMIC );
+	_pDataTransform->getOrCreateStateSet()->setAttributeAndModes( new osg::Scissor(), osg::StateAttribute::ON );
+	_pDataTransform->getStateSet()->setDataVariance( osg::Object::DYNAMIC );
+	memcpy(_dataRange,_scaledRange,sizeof(double)*4);
 
 	// Create the background
 	_pPlotGeode = new osg::Geode();
@@ -72,320 +154,500 @@ void osgtools::Plot::initialize()
 	}
 
 	// Create the axis labels
+	_pAxisGeode = new osg::Geode();
 	_pXLabelGeo = createXLabel();
-	_pPlotGeode->addDrawable( _pXLabelGeo.get() );
+	_pAxisGeode->addDrawable( _pXLabelGeo.get() );
 	_pYLabelGeo = createYLabel();
-	_pPlotGeode->addDrawable( _pYLabelGeo.get() );
+	_pAxisGeode->addDrawable( _pYLabelGeo.get() );
 
 	// Create the major axis tick lines
 	_pTickLinesGeo = createTickMarks();
-	_pPlotGeode->addDrawable( _pTickLinesGeo.get() );
+	_pAxisGeode->addDrawable( _pTickLinesGeo.get() );
 
 	// Add the major axis labels
-	createAddXLabels( _pPlotGeode.get(), _xLabelsGeo );
-	createAddYLabels( _pPlotGeode.get(), _yLabelsGeo );
-
-	// Add the plot geode to the scene graph
-	addChild(_pPlotGeode.get());
+	createAddXLabels( _pAxisGeode.get(), _xLabelsGeo );
+	createAddYLabels( _pAxisGeode.get(), _yLabelsGeo );
+
+	// Add the plot geodes to the scene graph
+	_pPlotTransform->addChild(_pPlotGeode.get());
+	_pPlotTransform->addChild(_pDataTransform.get());
+	addChild(_pPlotTransform.get());
+	addChild(_pAxisGeode.get());
 }
 
-osg::Geometry* osgtools::Plot::createBackground()
+void osgtools::Plot::updatePlotDimensions()
 {
-	osg::ref_ptr<osg::Geometry> pRectangle = new osg::Geometry();
-	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
-	
 	// Set the spacing for the height and width
 	_plotDim[0] = (int)((_yLabel.compare("")==0) ? RIGHT_SPACING : LEFT_SPACING);
 	_plotDim[1] = (int)((_xLabel.compare("")==0) ? TOP_SPACING : BOTTOM_SPACING);
 	_plotDim[2] = (int)((_width - (RIGHT_SPACING)) - _plotDim[0]);
 	_plotDim[3] = (int)((_height - (TOP_SPACING)) - _plotDim[1]);
+}
 
-	// Set the vertices
-	pVertices->push_back(osg::Vec3(_plotDim[0], _plotDim[1], BACKGROUND_Z));
-	pVertices->push_back(osg::Vec3(_plotDim[0] + _plotDim[2], _plotDim[1], BACKGROUND_Z));
-	pVertices->push_back(osg::Vec3(_plotDim[0] + _plotDim[2], _plotDim[1] + _plotDim[3], BACKGROUND_Z));
-	pVertices->push_back(osg::Vec3(_plotDim[0], _plotDim[1] + _plotDim[3], BACKGROUND_Z));
-	pRectangle->setVertexArray( pVertices.get() );
+void osgtools::Plot::updateLayoutTransform()
+{
+	if (!_pPlotTransform.valid())
+		return;
 
-	// Set the color
-	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
-	pColors->push_back(osg::Vec4(0.898, 0.898, 0.898, 1.0));
-	pRectangle->setColorArray( pColors.get() );
-	pRectangle->setColorBinding( osg::Geometry::BIND_OVERALL );
-	pRectangle->addPrimitiveSet( new osg::DrawArrays(GL_QUADS, 0, 4) );
-	
-	return pRectangle.release();
+	// Scale the layout dimensions onto the plot dimensions
+	float sx = (_layoutDim[2] > 0 ? (float)_plotDim[2]/_layoutDim[2] : 1.0);
+	float sy = (_layoutDim[3] > 0 ? (float)_plotDim[3]/_layoutDim[3] : 1.0);
+
+	_pPlotTransform->setMatrix(
+		osg::Matrix::translate(-_layoutDim[0], -_layoutDim[1], 0) *
+		osg::Matrix::scale(sx, sy, 1.0) *
+		osg::Matrix::translate(_plotDim[0], _plotDim[1], 0) );
+
+	// The cached chrome follows the same layout
+	if (_pChromeTransform.valid())
+		_pChromeTransform->setMatrix( _pPlotTransform->getMatrix() );
+
+	// Clip the data to the plot area
+	updateDataTransform();
 }
 
-osg::Geometry* osgtools::Plot::createMajorAxisGridLines()
+void osgtools::Plot::updateDataTransform()
 {
-	osg::ref_ptr<osg::Geometry> pLines = new osg::Geometry();
-	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
+	if (!_pDataTransform.valid())
+		return;
+
+	// Scale each axis from the built range onto the current one, in layout pixels
+	osg::Matrix matrix;
+	for (int axis=0; axis < 2; axis++) {
+		double viewSize = _scaledRange[axis + 2] - _scaledRange[axis];
+		double dataSize = _dataRange[axis + 2] - _dataRange[axis];
+		double scale = (viewSize != 0 ? dataSize / viewSize : 1.0);
+		double offset = (viewSize != 0 ? (_dataRange[axis] - _scaledRange[axis]) * _layoutDim[axis + 2] / viewSize : 0.0);
+		matrix(axis, axis) = scale;
+		matrix(3, axis) = _layoutDim[axis] * (1.0 - scale) + offset;
+	}
+	_pDataTransform->setMatrix( matrix );
+
+	osg::Scissor* pScissor = static_cast<osg::Scissor*>( _pDataTransform->getStateSet()->getAttribute(osg::StateAttribute::SCISSOR) );
+	if (pScissor)
+		pScissor->setScissor( _windowOffset[0] + _plotDim[0], _windowOffset[1] + _plotDim[1], _plotDim[2], _plotDim[3] );
+}
+
+void osgtools::Plot::rebaseLayout()
+{
+	if (memcmp(_layoutDim,_plotDim,sizeof(int)*4) == 0)
+		return;
 
+	// Build at the current dimensions
+	memcpy(_layoutDim,_plotDim,sizeof(int)*4);
+	updateLayoutTransform();
+	updateBackground();
+}
+
+void osgtools::Plot::layoutAxes()
+{
+	// Reposition the axis labels
+	if (_pXLabelGeo.valid())
+		positionXLabel(_pXLabelGeo.get());
+	if (_pYLabelGeo.valid())
+		positionYLabel(_pYLabelGeo.get());
+
+	// Refill the tick marks in place
+	if (_pTickLinesGeo.valid())
+		updateLines(_pTickLinesGeo.get(), 0);
+
+	// Reposition the major axis labels
+	resetAxisLabels();
+}
+
+int osgtools::Plot::getMaxTicks( int axis ) const
+{
+	return std::max(1, _layoutDim[axis + 2] / MIN_TICK_SPACING);
+}
 
-	// Create the x axis major grid lines
-	if (_majorAxisGrid[0] > 0) {
+float osgtools::Plot::getNiceGrid( int axis, float min, float max ) const
+{
+	if (!_scales[axis]->isValid(min) || !_scales[axis]->isValid(max))
+		return 0;
+	return _scales[axis]->getNiceStep(_scales[axis]->forward(max) - _scales[axis]->forward(min),
+		std::max(1, _plotDim[axis + 2] / MAJOR_GRID_SPACING));
+}
+
+void osgtools::Plot::updateScaledRange()
+{
+	for (int i=0; i < 4; i++)
+		_scaledRange[i] = _scales[i % 2]->forward(_range[i]);
+}
 
-		float xVal = _range[0] - _majorAxisGrid[0] * (int)(_range[0]/_majorAxisGrid[0]);
-		xVal = (_range[0] <= 0 ? _range[0] - xVal : _range[0] + (_majorAxisGrid[0] - xVal));
+int osgtools::Plot::getValuePixel( int axis, float value, const int* dim ) const
+{
+	if (value < _range[axis] || value > _range[axis + 2])
+		return -1;
 
-		while (xVal < _range[2]) {
-			// Add the major line
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1], MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1] + _plotDim[3], MAJORMINORAXES_Z));
-			
-			// Update x
-			xVal += _majorAxisGrid[0];
+	// Interpolate in the scale space of the axis
+	double val = _scales[axis]->forward(value) - _scaledRange[axis];
+	double pxPerUnit = (double)dim[axis + 2]/(_scaledRange[axis + 2] - _scaledRange[axis]);
+	return dim[axis] + (val * pxPerUnit);
+}
+
+void osgtools::Plot::computeTicks( int axis, float step, const int* dim, std::vector<PlotTick>& ticks, bool bMinor ) const
+{
+	ticks.clear();
+
+	// Ticks are computed from their index, so tiny steps cannot stall
+	_scales[axis]->getTicks(_range[axis], _range[axis + 2], step, getMaxTicks(axis), _tickValues, bMinor);
+	for (int i=0; i < _tickValues.size(); i++) {
+		PlotTick tick;
+		tick.value = _tickValues[i];
+		tick.pixel = getValuePixel(axis, tick.value, dim);
+		ticks.push_back(tick);
+	}
+}
+
+int osgtools::Plot::computeTickLabels( int axis, const std::vector<PlotTick>& ticks, std::vector<PlotLabel>& labels ) const
+{
+	// Use values if no strings are available
+	const std::vector<std::string>& strings = (axis == 0 ? _xLabels : _yLabels);
+	bool bValues = strings.empty();
+
+	// Only grow, so labels past the kept ones keep their storage
+	if (labels.size() < ticks.size())
+		labels.resize(ticks.size());
+	for (int i=0; i < ticks.size(); i++) {
+		PlotLabel& label = labels[i];
+
+		// Format in place, so recycled labels keep their storage
+		if (bValues) {
+			char s[32];
+			_scales[axis]->formatLabel(ticks[i].value, s, sizeof(s));
+			label.text = s;
 		}
+		else if (i < strings.size())
+			label.text = strings[i];
+		else
+			label.text.clear();
+
+		label.size = TICK_LABEL_SIZE;
+		label.width = LabelFont::getTextWidth(label.text, label.size);
+		label.bRotated = false;
+
+		// Get the location
+		if (axis == 0)
+			label.position.set(ticks[i].pixel - (label.width/2), _plotDim[1] - 15, 0);
+		else
+			label.position.set(_plotDim[0] - label.width - 15, ticks[i].pixel, 0);
 	}
-		// Create the y axis major grid lines
-	if (_majorAxisGrid[1] > 0) {
-
-		float yVal = _range[1] - _majorAxisGrid[1] * (int)(_range[1]/_majorAxisGrid[1]);
-		yVal = (_range[1] <= 0 ? _range[1] - yVal : _range[1] + (_majorAxisGrid[1] - yVal));
-
-		while (yVal < _range[3]) {
-			// Add the major line
-			pVertices->push_back(osg::Vec3( _plotDim[0], getYValuePixel(yVal), MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( _plotDim[0] + _plotDim[2], getYValuePixel(yVal), MAJORMINORAXES_Z));
-			
-			// Update y
-			yVal += _majorAxisGrid[1];
+
+	return cullTickLabels(axis, ticks, labels);
+}
+
+int osgtools::Plot::cullTickLabels( int axis, const std::vector<PlotTick>& ticks, std::vector<PlotLabel>& labels ) const
+{
+	// Each label covers its width along x, or its height along y. Labels
+	// are kept by the index of their grid line, i.e. value/step in scale space.
+	double step = _majorAxisGrid[axis];
+
+	// Find the lowest level of thinning at which no kept labels overlap
+	long stride = 1;
+	for (; stride < (1L << 30); stride *= 2) {
+		bool bOverlap = false;
+		bool bFirst = true;
+		float end = 0;
+		for (int i=0; !bOverlap && i < ticks.size(); i++) {
+			if (labels[i].text.empty() || (step > 0 && lround(_scales[axis]->forward(ticks[i].value)/step) % stride != 0))
+				continue;
+
+			float start = (axis == 0 ? labels[i].position.x() : ticks[i].pixel - labels[i].size/2);
+			bOverlap = (!bFirst && start < end + LABEL_SPACING);
+			end = (axis == 0 ? start + labels[i].width : start + labels[i].size);
+			bFirst = false;
 		}
+		if (!bOverlap || step <= 0)
+			break;
 	}
+
+	// Keep the labels of the level, sweeping out any overlap left
+	int numKept = 0;
+	float end = 0;
+	for (int i=0; i < ticks.size(); i++) {
+		if (labels[i].text.empty() || (step > 0 && lround(_scales[axis]->forward(ticks[i].value)/step) % stride != 0))
+			continue;
+
+		float start = (axis == 0 ? labels[i].position.x() : ticks[i].pixel - labels[i].size/2);
+		if (numKept > 0 && start < end + LABEL_SPACING)
+			continue;
+		end = (axis == 0 ? start + labels[i].width : start + labels[i].size);
+
+		// Swap, so the culled labels keep their storage for later rebuilds
+		if (numKept != i)
+			labels[numKept].text.swap(labels[i].text);
+		labels[numKept].position = labels[i].position;
+		labels[numKept].size = labels[i].size;
+		labels[numKept].width = labels[i].width;
+		labels[numKept].bRotated = labels[i].bRotated;
+		numKept++;
+	}
+	return numKept;
+}
+
+void osgtools::Plot::computeTitle( int axis, PlotLabel& label ) const
+{
+	label.text = (axis == 0 ? _xLabel : _yLabel);
+	label.size = TITLE_SIZE;
+	label.bRotated = (axis == 1);
+
+	label.width = LabelFont::getTextWidth(label.text, label.size);
+
+	// Center along the plot area
+	if (axis == 0)
+		label.position.set(_plotDim[0] + (_plotDim[2]/2) - (label.width/2), 10, TEXT_Z);
+	else
+		label.position.set(15, _plotDim[1] + (_plotDim[3]/2) - (label.width/2), TEXT_Z);
+}
+
+void osgtools::Plot::appendAxisLines( int axis, const std::vector<PlotTick>& ticks, int from, int to, std::vector<osg::Vec3>& lines ) const
+{
+	for (int i=0; i < ticks.size(); i++) {
+		if (axis == 0) {
+			lines.push_back(osg::Vec3( ticks[i].pixel, from, MAJORMINORAXES_Z));
+			lines.push_back(osg::Vec3( ticks[i].pixel, to, MAJORMINORAXES_Z));
+		}
+		else {
+			lines.push_back(osg::Vec3( from, ticks[i].pixel, MAJORMINORAXES_Z));
+			lines.push_back(osg::Vec3( to, ticks[i].pixel, MAJORMINORAXES_Z));
+		}
+	}
+}
+
+osg::Geometry* osgtools::Plot::createBackground()
+{
+	osg::ref_ptr<osg::Geometry> pRectangle = new osg::Geometry();
+	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
 	
 	// Set the vertices
-	pLines->setVertexArray( pVertices.get() );
+	pVertices->push_back(osg::Vec3(_layoutDim[0], _layoutDim[1], BACKGROUND_Z));
+	pVertices->push_back(osg::Vec3(_layoutDim[0] + _layoutDim[2], _layoutDim[1], BACKGROUND_Z));
+	pVertices->push_back(osg::Vec3(_layoutDim[0] + _layoutDim[2], _layoutDim[1] + _layoutDim[3], BACKGROUND_Z));
+	pVertices->push_back(osg::Vec3(_layoutDim[0], _layoutDim[1] + _layoutDim[3], BACKGROUND_Z));
+	pRectangle->setVertexArray( pVertices.get() );
 
 	// Set the color
 	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
-	pColors->push_back(osg::Vec4(1.0, 1.0, 1.0, 1.0));
-	pLines->setColorArray( pColors.get() );
-	pLines->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-	// Set the line width
-	osg::ref_ptr<osg::LineWidth> pLineWidth = new osg::LineWidth();
-	pLineWidth->setWidth(2.0);
-	pLines->getOrCreateStateSet()->setAttributeAndModes( pLineWidth.get(), osg::StateAttribute::ON );
-
-	pLines->addPrimitiveSet( new osg::DrawArrays(GL_LINES, 0, pVertices->getNumElements() ));
+	pColors->push_back(BACKGROUND_COLOR);
+	pRectangle->setColorArray( pColors.get() );
+	pRectangle->setColorBinding( osg::Geometry::BIND_OVERALL );
+	pRectangle->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( pRectangle.get() );
 	
-	return pLines.release();
+	return pRectangle.release();
 }
 
-osg::Geometry* osgtools::Plot::createMinorAxisGridLines()
+void osgtools::Plot::updateBackground()
 {
-	osg::ref_ptr<osg::Geometry> pLines = new osg::Geometry();
-	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
+	if (!_pBackgroundGeo.valid())
+		return;
 
-	// Create the x axis minor grid lines
-	if (_minorAxisGrid[0] > 0) {
+	osg::Vec3Array* pVertices = dynamic_cast<osg::Vec3Array*>( _pBackgroundGeo->getVertexArray() );
+	if (!pVertices || pVertices->size() != 4)
+		return;
 
-		float xVal = _range[0] - _majorAxisGrid[0] * (int)(_range[0]/_majorAxisGrid[0]);
-		xVal = (_range[0] <= 0 ? _range[0] - xVal : _range[0] + (_majorAxisGrid[0] - xVal));
+	// Update the vertices in place
+	(*pVertices)[0].set(_layoutDim[0], _layoutDim[1], BACKGROUND_Z);
+	(*pVertices)[1].set(_layoutDim[0] + _layoutDim[2], _layoutDim[1], BACKGROUND_Z);
+	(*pVertices)[2].set(_layoutDim[0] + _layoutDim[2], _layoutDim[1] + _layoutDim[3], BACKGROUND_Z);
+	(*pVertices)[3].set(_layoutDim[0], _layoutDim[1] + _layoutDim[3], BACKGROUND_Z);
+	pVertices->dirty();
+	_pBackgroundGeo->dirtyBound();
+}
 
-		while (xVal < _range[2]) {
-			// Add the minor line
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1], MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1] + _plotDim[3], MAJORMINORAXES_Z));
-			
-			// Update x
-			xVal += _minorAxisGrid[0];
-		}
-	}
+osg::Geometry* osgtools::Plot::createMajorAxisGridLines()
+{
+	return createGridLines(_majorAxisGrid, MAJOR_GRID_WIDTH);
+}
 
-		// Create the y axis minor grid lines
-	if (_minorAxisGrid[1] > 0) {
+osg::Geometry* osgtools::Plot::createMinorAxisGridLines()
+{
+	return createGridLines(_minorAxisGrid, MINOR_GRID_WIDTH);
+}
 
-		float yVal = _range[1] - _majorAxisGrid[1] * (int)(_range[1]/_majorAxisGrid[1]);
-		yVal = (_range[1] <= 0 ? _range[1] - yVal : _range[1] + (_majorAxisGrid[1] - yVal));
+osg::Geometry* osgtools::Plot::createGridLines( const float* grid, float width )
+{
+	osg::ref_ptr<osg::Geometry> pLines = new osg::Geometry();
+	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
 
-		while (yVal < _range[3]) {
-			// Add the minor line
-			pVertices->push_back(osg::Vec3( _plotDim[0], getYValuePixel(yVal), MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( _plotDim[0] + _plotDim[2], getYValuePixel(yVal), MAJORMINORAXES_Z));
-			
-			// Update y
-			yVal += _minorAxisGrid[1];
-		}
-	}
+	// Create the grid lines
+	fillGridLines(pVertices.get(), grid);
 	
 	// Set the vertices
 	pLines->setVertexArray( pVertices.get() );
 
 	// Set the color
 	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
-	pColors->push_back(osg::Vec4(1.0, 1.0, 1.0, 1.0));
+	pColors->push_back(GRID_COLOR);
 	pLines->setColorArray( pColors.get() );
 	pLines->setColorBinding( osg::Geometry::BIND_OVERALL );
 
 	// Set the line width
-	osg::ref_ptr<osg::LineWidth> pLineWidth = new osg::LineWidth();
-	pLineWidth->setWidth(1.0);
-	pLines->getOrCreateStateSet()->setAttributeAndModes( pLineWidth.get(), osg::StateAttribute::ON );
+	Shaders::setLineWidth( pLines->getOrCreateStateSet(), width );
 
 	pLines->addPrimitiveSet( new osg::DrawArrays(GL_LINES, 0, pVertices->getNumElements() ));
+	Shaders::setupGeometry( pLines.get() );
 	
 	return pLines.release();
 }
 
-osgText::Text* osgtools::Plot::createXLabel()
+void osgtools::Plot::fillGridLines( osg::Vec3Array* pVertices, const float* grid )
 {
-	osg::ref_ptr<osgText::Text> pLabel = new osgText::Text();
+	bool bMinor = (grid == _minorAxisGrid);
 
-	pLabel->setCharacterSize(20);
-	pLabel->setFont("/fonts/arial.ttf");
-	pLabel->setText(_xLabel.c_str());
-	pLabel->setCharacterSizeMode(osgText::Text::SCREEN_COORDS);
-	pLabel->setAxisAlignment(osgText::Text::SCREEN);
-	pLabel->setColor(osg::Vec4(0, 0, 0, 1.0));
-	pLabel->setDrawMode(osgText::Text::TEXT);
+	// Create the x axis grid lines
+	computeTicks(0, grid[0], _layoutDim, _ticks, bMinor);
+	appendAxisLines(0, _ticks, _layoutDim[1], _layoutDim[1] + _layoutDim[3], pVertices->asVector());
 
-	// Get the location
-	int labelWidth = 7 * _xLabel.size();
-	int xPos = _plotDim[0] + (_plotDim[2]/2) - (labelWidth/2);
-	pLabel->setPosition(osg::Vec3(xPos, 10, TEXT_Z));
-	
-	return pLabel.release();
+	// Create the y axis grid lines
+	computeTicks(1, grid[1], _layoutDim, _ticks, bMinor);
+	appendAxisLines(1, _ticks, _layoutDim[0], _layoutDim[0] + _layoutDim[2], pVertices->asVector());
+}
+
+void osgtools::Plot::updateLines( osg::Geometry* pLines, const float* grid )
+{
+	osg::Vec3Array* pVertices = dynamic_cast<osg::Vec3Array*>( pLines->getVertexArray() );
+	osg::DrawArrays* pDrawArrays = dynamic_cast<osg::DrawArrays*>( pLines->getPrimitiveSet(0) );
+	if (!pVertices || !pDrawArrays)
+		return;
+
+	// Refill the vertices in place, keeping their storage
+	pVertices->clear();
+	if (grid)
+		fillGridLines(pVertices, grid);
+	else
+		fillTickMarks(pVertices);
+	pVertices->dirty();
+	pDrawArrays->setCount(pVertices->getNumElements());
+	pLines->dirtyBound();
+}
+
+osgText::Text* osgtools::Plot::createXLabel()
+{
+	PlotLabel label;
+	computeTitle(0, label);
+	return createLabelText(label);
 }
 
 osgText::Text* osgtools::Plot::createYLabel()
+{
+	PlotLabel label;
+	computeTitle(1, label);
+	return createLabelText(label);
+}
+
+osgText::Text* osgtools::Plot::createLabelText( const PlotLabel& label )
 {
 	osg::ref_ptr<osgText::Text> pLabel = new osgText::Text();
 
-	pLabel->setCharacterSize(20);
-	pLabel->setFont("/fonts/arial.ttf");
-	pLabel->setText(_yLabel.c_str());
+	pLabel->setCharacterSize(label.size);
+	LabelFont::setupText(pLabel.get());
+	pLabel->setText(label.text.c_str());
 	pLabel->setCharacterSizeMode(osgText::Text::SCREEN_COORDS);
 	pLabel->setAxisAlignment(osgText::Text::SCREEN);
-	pLabel->setColor(osg::Vec4(0, 0, 0, 1.0));
+	pLabel->setColor(TEXT_COLOR);
 	pLabel->setDrawMode(osgText::Text::TEXT);
-	pLabel->setRotation(osg::Quat(3.14195/2, osg::Vec3(0.0, 0.0, 1.0)));
+	if (label.bRotated)
+		pLabel->setRotation(osg::Quat(osg::PI_2, osg::Vec3(0.0, 0.0, 1.0)));
 
 	// Get the location
-	int labelWidth = 7 * _yLabel.size();
-	int yPos = _plotDim[1] + (_plotDim[3]/2) - (labelWidth/2);
-	pLabel->setPosition(osg::Vec3(15, yPos, TEXT_Z));
-	
+	pLabel->setPosition(label.position);
+
 	return pLabel.release();
 }
 
-osg::Geometry* osgtools::Plot::createTickMarks()
+void osgtools::Plot::updateLabelText( osgText::Text* pText, const PlotLabel& label )
 {
-	osg::ref_ptr<osg::Geometry> pLines = new osg::Geometry();
-	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
-
-
-	// Create the x axis major grid lines
-	if (_majorAxisGrid[0] > 0) {
-
-		float xVal = _range[0] - _majorAxisGrid[0] * (int)(_range[0]/_majorAxisGrid[0]);
-		xVal = (_range[0] <= 0 ? _range[0] - xVal : _range[0] + (_majorAxisGrid[0] - xVal));
+	// Only touch the text when it changed, as osgText rebuilds its glyphs
+	const osgText::String& text = pText->getText();
+	bool bSame = (text.size() == label.text.size());
+	for (int i=0; bSame && i < label.text.size(); i++)
+		bSame = (text[i] == (unsigned char)label.text[i]);
+	if (!bSame)
+		pText->setText(label.text.c_str());
+
+	if (pText->getPosition() != label.position)
+		pText->setPosition(label.position);
+}
 
-		while (xVal < _range[2]) {
-			// Add the major line
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1], MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( getXValuePixel(xVal), _plotDim[1] - 5, MAJORMINORAXES_Z));
-			
-			// Update x
-			xVal += _majorAxisGrid[0];
-		}
-	}
+void osgtools::Plot::positionXLabel( osgText::Text* pLabel )
+{
+	PlotLabel label;
+	computeTitle(0, label);
+	pLabel->setPosition(label.position);
+}
 
-		// Create the y axis major grid lines
-	if (_majorAxisGrid[1] > 0) {
+void osgtools::Plot::positionYLabel( osgText::Text* pLabel )
+{
+	PlotLabel label;
+	computeTitle(1, label);
+	pLabel->setPosition(label.position);
+}
 
-		float yVal = _range[1] - _majorAxisGrid[1] * (int)(_range[1]/_majorAxisGrid[1]);
-		yVal = (_range[1] <= 0 ? _range[1] - yVal : _range[1] + (_majorAxisGrid[1] - yVal));
+osg::Geometry* osgtools::Plot::createTickMarks()
+{
+	osg::ref_ptr<osg::Geometry> pLines = new osg::Geometry();
+	osg::ref_ptr<osg::Vec3Array> pVertices = new osg::Vec3Array();
 
-		while (yVal < _range[3]) {
-			// Add the major line
-			pVertices->push_back(osg::Vec3( _plotDim[0], getYValuePixel(yVal), MAJORMINORAXES_Z));
-			pVertices->push_back(osg::Vec3( _plotDim[0] - 5, getYValuePixel(yVal), MAJORMINORAXES_Z));
-			
-			// Update y
-			yVal += _majorAxisGrid[1];
-		}
-	}
+	// Create the tick lines
+	fillTickMarks(pVertices.get());
 	
 	// Set the vertices
 	pLines->setVertexArray( pVertices.get() );
 
 	// Set the color
 	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
-	pColors->push_back(osg::Vec4(0.0, 0.0, 0.0, 1.0));
+	pColors->push_back(TICK_COLOR);
 	pLines->setColorArray( pColors.get() );
 	pLines->setColorBinding( osg::Geometry::BIND_OVERALL );
 
 	// Set the line width
-	osg::ref_ptr<osg::LineWidth> pLineWidth = new osg::LineWidth();
-	pLineWidth->setWidth(2.0);
-	pLines->getOrCreateStateSet()->setAttributeAndModes( pLineWidth.get(), osg::StateAttribute::ON );
+	Shaders::setLineWidth( pLines->getOrCreateStateSet(), TICK_WIDTH );
 
 	pLines->addPrimitiveSet( new osg::DrawArrays(GL_LINES, 0, pVertices->getNumElements() ));
+	Shaders::setupGeometry( pLines.get() );
 	
 	return pLines.release();
 }
 
+void osgtools::Plot::fillTickMarks( osg::Vec3Array* pVertices )
+{
+	// Create the x axis major tick lines
+	computeTicks(0, _majorAxisGrid[0], _plotDim, _ticks);
+	appendAxisLines(0, _ticks, _plotDim[1], _plotDim[1] - TICK_LENGTH, pVertices->asVector());
+
+	// Create the y axis major tick lines
+	computeTicks(1, _majorAxisGrid[1], _plotDim, _ticks);
+	appendAxisLines(1, _ticks, _plotDim[0], _plotDim[0] - TICK_LENGTH, pVertices->asVector());
+}
+
 void osgtools::Plot::createAddXLabels( osg::Geode* pGeode, std::vector<osg::ref_ptr<osgText::Text>>& xLabelsGeo )
 {
 	// Make sure the geode is good
 	if (!pGeode)
 		return;
 
-	// Use values if no strings are available
-	bool bValues = ( _xLabels.size() == 0 ? true : false);
-	if (bValues) _xLabels.clear();
-
-	// Clear the values
-	if (xLabelsGeo.size() > 0 ) {
-		for (int i=0; i < xLabelsGeo.size(); i++) {
-			// Remove the label
-			pGeode->removeDrawable(xLabelsGeo[i].release());
-		}
-		xLabelsGeo.clear();
+	// Compute the labels
+	computeTicks(0, _majorAxisGrid[0], _plotDim, _ticks);
+	int numLabels = computeTickLabels(0, _ticks, _labels);
+
+	// Remove the labels no longer needed
+	while (xLabelsGeo.size() > numLabels) {
+		pGeode->removeDrawable(xLabelsGeo.back().get());
+		xLabelsGeo.pop_back();
 	}
 
-	// Create new labels
-	if (_majorAxisGrid[0] > 0) {
-		
-		float xVal = _range[0] - _majorAxisGrid[0] * (int)(_range[0]/_majorAxisGrid[0]);
-		xVal = (_range[0] <= 0 ? _range[0] - xVal : _range[0] + (_majorAxisGrid[0] - xVal));
-
-		int i = 0;
-		while (xVal < _range[2]) {
-			std::stringstream s;
-
-			if (bValues)
-				s << xVal;
-			else {
-				if (i < _xLabels.size())
-					s << _xLabels[i];
-				i++;
-			}
-
-			osg::ref_ptr<osgText::Text> pLabel = new osgText::Text();
-
-			pLabel->setCharacterSize(16);
-			pLabel->setFont("/fonts/arial.ttf");
-			pLabel->setText(s.str().c_str());
-			pLabel->setCharacterSizeMode(osgText::Text::SCREEN_COORDS);
-			pLabel->setAxisAlignment(osgText::Text::SCREEN);
-			pLabel->setColor(osg::Vec4(0, 0, 0, 1.0));
-			pLabel->setDrawMode(osgText::Text::TEXT);
-
-			// Get the location
-			int labelWidth = 7 * s.str().size();
-			int xPos = getXValuePixel(xVal) - (labelWidth/2);
-			pLabel->setPosition(osg::Vec3(xPos, _plotDim[1] - 15, 0));
-
-			// Add the label
-			xLabelsGeo.push_back(pLabel);
-			pGeode->addDrawable(pLabel);
-
-			// Update x
-			xVal += _majorAxisGrid[0];
+	for (int i=0; i < numLabels; i++) {
+		// Recycle the existing labels
+		if (i < xLabelsGeo.size()) {
+			updateLabelText(xLabelsGeo[i].get(), _labels[i]);
+			continue;
 		}
+		
+		// Add the label
+		osg::ref_ptr<osgText::Text> pLabel = createLabelText(_labels[i]);
+		xLabelsGeo.push_back(pLabel);
+		pGeode->addDrawable(pLabel);
 	}
 	
 	// Update the geode
@@ -398,59 +660,27 @@ void osgtools::Plot::createAddYLabels( osg::Geode* pGeode, std::vector<osg::ref_
 	if (!pGeode)
 		return;
 
-	// Use values if no strings are available
-	bool bValues = ( _yLabels.size() == 0 ? true : false);
-	if (bValues) _yLabels.clear();
-
-	// Clear the values
-	if (yLabelsGeo.size() > 0 ) {
-		for (int i=0; i < yLabelsGeo.size(); i++) {
-			// Remove the label
-			pGeode->removeDrawable(yLabelsGeo[i].release());
-		}
-		yLabelsGeo.clear();
+	// Compute the labels
+	computeTicks(1, _majorAxisGrid[1], _plotDim, _ticks);
+	int numLabels = computeTickLabels(1, _ticks, _labels);
+
+	// Remove the labels no longer needed
+	while (yLabelsGeo.size() > numLabels) {
+		pGeode->removeDrawable(yLabelsGeo.back().get());
+		yLabelsGeo.pop_back();
 	}
 
-	// Create new labels
-	if (_majorAxisGrid[1] > 0) {
-		
-		float yVal = _range[1] - _majorAxisGrid[1] * (int)(_range[1]/_majorAxisGrid[1]);
-		yVal = (_range[1] <= 0 ? _range[1] - yVal : _range[1] + (_majorAxisGrid[1] - yVal));
-
-		int i = 0;
-		while (yVal < _range[3]) {
-			std::stringstream s;
-
-			if (bValues)
-				s << yVal;
-			else {
-				if (i < _yLabels.size())
-					s << _yLabels[i];
-				i++;
-			}
-
-			osg::ref_ptr<osgText::Text> pLabel = new osgText::Text();
-
-			pLabel->setCharacterSize(16);
-			pLabel->setFont("/fonts/arial.ttf");
-			pLabel->setText(s.str().c_str());
-			pLabel->setCharacterSizeMode(osgText::Text::SCREEN_COORDS);
-			pLabel->setAxisAlignment(osgText::Text::SCREEN);
-			pLabel->setColor(osg::Vec4(0, 0, 0, 1.0));
-			pLabel->setDrawMode(osgText::Text::TEXT);
-
-			// Get the location
-			int labelWidth = 3 * s.str().size();
-			int yPos = getYValuePixel(yVal);
-			pLabel->setPosition(osg::Vec3(_plotDim[0] - labelWidth - 15, yPos, 0));
-
-			// Add the label
-			yLabelsGeo.push_back(pLabel);
-			pGeode->addDrawable(pLabel);
-
-			// Update y
-			yVal += _majorAxisGrid[1];
+	for (int i=0; i < numLabels; i++) {
+		// Recycle the existing labels
+		if (i < yLabelsGeo.size()) {
+			updateLabelText(yLabelsGeo[i].get(), _labels[i]);
+			continue;
 		}
+		
+		// Add the label
+		osg::ref_ptr<osgText::Text> pLabel = createLabelText(_labels[i]);
+		yLabelsGeo.push_back(pLabel);
+		pGeode->addDrawable(pLabel);
 	}
 	
 	// Update the geode
@@ -459,8 +689,9 @@ void osgtools::Plot::createAddYLabels( osg::Geode* pGeode, std::vector<osg::ref_
 
 void osgtools::Plot::resetAxisLabels()
 {
-	createAddXLabels(_pPlotGeode.get(), _xLabelsGeo);
-	createAddYLabels(_pPlotGeode.get(), _yLabelsGeo);
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "resetAxisLabels");
+	createAddXLabels(_pAxisGeode.get(), _xLabelsGeo);
+	createAddYLabels(_pAxisGeode.get(), _yLabelsGeo);
 }
 
 void osgtools::Plot::resize( int width, int height )
@@ -474,97 +705,526 @@ void osgtools::Plot::resize( int width, int height )
 	
 	// Set the projection
 	setProjectionMatrix(osg::Matrix::ortho2D(0,_width,0,_height));
-	setViewport(0,0,_width,_height);
+	setViewport(_windowOffset[0],_windowOffset[1],_width,_height);
 
 	// Set the view
 	setReferenceFrame(osg::Transform::ABSOLUTE_RF);
 	setViewMatrix(osg::Matrix::identity());
 
-	// Clear the depth
-	setClearMask(GL_DEPTH_BUFFER_BIT);
+	// Clear the depth, once per dashboard for tiles
+	setClearMask(_bTile ? 0 : GL_DEPTH_BUFFER_BIT);
 
-	// Disable lighting
+	// Draw with the shared programs
+	getOrCreateStateSet()->setAttributeAndModes(Shaders::getColorProgram(), osg::StateAttribute::ON);
+	Shaders::setViewport(getOrCreateStateSet(), _width, _height);
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
 	getOrCreateStateSet()->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
+#endif
+
+	// Rescale the existing layout
+	if (_bInitialized) {
+		OSGTOOLS_BUILD_SCOPE(_buildStats, this, "resize");
+		updatePlotDimensions();
+		updateLayoutTransform();
+		layoutAxes();
+		if (_bChromeCaching)
+			updateChromeCache();
+		dirtyLayout();
+	}
 }
 
 void osgtools::Plot::setRange( float xmin, float ymin, float xmax, float ymax )
 {
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setRange");
 	_range[0] = xmin;
 	_range[1] = ymin;
 	_range[2] = xmax;
 	_range[3] = ymax;
+	updateScaledRange();
+
+	// Everything below is rebuilt, so build at the current dimensions
+	rebaseLayout();
+	updateAxes();
+
+	// Update subclass functions
+	redrawData();
+	dirtyLayout();
+}
 
+void osgtools::Plot::setViewRange( float xmin, float ymin, float xmax, float ymax )
+{
+	_range[0] = xmin;
+	_range[1] = ymin;
+	_range[2] = xmax;
+	_range[3] = ymax;
+	updateScaledRange();
+
+	// Move the data, the axes follow on updateViewLayout
+	updateDataTransform();
+	_bViewLayoutDirty = true;
+	dirtyRedraw();
+}
+
+void osgtools::Plot::updateViewLayout()
+{
+	if (!_bViewLayoutDirty)
+		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "updateViewLayout");
+	updateAxes();
+	dirtyLayout();
+}
+
+void osgtools::Plot::updateAxes()
+{
 	// Update the grid lines
 	setMajorAxisGrid(_majorAxisGrid[0], _majorAxisGrid[1]);
 	setMinorAxisGrid(_minorAxisGrid[0], _minorAxisGrid[1]);	
 
 	// Update the axis labels
-	createAddXLabels(_pPlotGeode.get(), _xLabelsGeo);
-	createAddYLabels(_pPlotGeode.get(), _yLabelsGeo);
+	createAddXLabels(_pAxisGeode.get(), _xLabelsGeo);
+	createAddYLabels(_pAxisGeode.get(), _yLabelsGeo);
+	_bViewLayoutDirty = false;
+}
 
-	// Update subclass functions
+void osgtools::Plot::redrawData()
+{
+	// The data is built at the current range, so it needs no transform
 	redraw();
+	memcpy(_dataRange,_scaledRange,sizeof(double)*4);
+	updateDataTransform();
+}
+
+void osgtools::Plot::setAxisScale( int axis, AxisScale* pScale )
+{
+	if (axis < 0 || axis > 1)
+		return;
+	_scales[axis] = (pScale ? pScale : new LinearScale());
+
+	// Rebuild everything in the new scale
+	setRange(_range[0], _range[1], _range[2], _range[3]);
 }
 
 void osgtools::Plot::setMajorAxisGrid( float xGrid, float yGrid )
 {
 	if (xGrid < 0 || yGrid < 0)
 		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setMajorAxisGrid");
 	_majorAxisGrid[0] = xGrid;
 	_majorAxisGrid[1] = yGrid;
 
-	// Remove the drawables and refresh
-	_pPlotGeode->removeDrawable( _pMajorAxisGridLinesGeo.release() );
-	_pPlotGeode->removeDrawable( _pTickLinesGeo.release() );
-	
-	// Create new grid lines
-	_pMajorAxisGridLinesGeo = createMajorAxisGridLines();
-	_pTickLinesGeo = createTickMarks();
-
-	// Add
-	_pPlotGeode->addDrawable( _pMajorAxisGridLinesGeo.get() );
-	_pPlotGeode->addDrawable( _pTickLinesGeo.get() );
+	// Refill the grid lines in place, or create them
+	if (_pMajorAxisGridLinesGeo.valid()) {
+		updateLines( _pMajorAxisGridLinesGeo.get(), _majorAxisGrid );
+	}
+	else {
+		_pMajorAxisGridLinesGeo = createMajorAxisGridLines();
+		_pPlotGeode->addDrawable( _pMajorAxisGridLinesGeo.get() );
+	}
+	if (_pTickLinesGeo.valid())
+		updateLines( _pTickLinesGeo.get(), 0 );
 
 	// Reset the labels
 	resetAxisLabels();
 
 	_pPlotGeode->dirtyBound();
+	dirtyLayout();
 }
 
 void osgtools::Plot::setMinorAxisGrid( float xGrid, float yGrid )
 {
 	if (xGrid < 0 || yGrid < 0)
 		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setMinorAxisGrid");
 	_minorAxisGrid[0] = xGrid;
 	_minorAxisGrid[1] = yGrid;
 
-	// Remove the drawables and refresh
-	_pPlotGeode->removeDrawable( _pMinorAxisGridLinesGeo.release() );
-	
-	// Create new grid lines
-	_pMinorAxisGridLinesGeo = createMinorAxisGridLines();
-
-	// Add
-	_pPlotGeode->addDrawable( _pMinorAxisGridLinesGeo.get() );
+	// Refill the grid lines in place, or create them
+	if (_pMinorAxisGridLinesGeo.valid()) {
+		updateLines( _pMinorAxisGridLinesGeo.get(), _minorAxisGrid );
+	}
+	else {
+		_pMinorAxisGridLinesGeo = createMinorAxisGridLines();
+		_pPlotGeode->addDrawable( _pMinorAxisGridLinesGeo.get() );
+	}
 	_pPlotGeode->dirtyBound();
+	dirtyLayout();
+}
+
+void osgtools::Plot::setXLabel( std::string& xLabel )
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setXLabel");
+	_xLabel = xLabel;
+
+	// Update the label text
+	if (_pXLabelGeo.valid()) {
+		_pXLabelGeo->setText(_xLabel.c_str());
+		positionXLabel(_pXLabelGeo.get());
+	}
+	dirtyLayout();
+}
+
+void osgtools::Plot::setYLabel( std::string& yLabel )
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setYLabel");
+	_yLabel = yLabel;
+
+	// Update the label text
+	if (_pYLabelGeo.valid()) {
+		_pYLabelGeo->setText(_yLabel.c_str());
+		positionYLabel(_pYLabelGeo.get());
+	}
+	dirtyLayout();
+}
+
+void osgtools::Plot::dirtyLayout()
+{
+	_chromeCached.setAllElementsTo(false);
+	_numLayouts++;
+	dirtyRedraw();
+}
+
+void osgtools::Plot::createChromeCache()
+{
+	// Create the cache texture
+	_pChromeTexture = new osg::Texture2D();
+	_pChromeTexture->setInternalFormat(GL_RGBA);
+	_pChromeTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::NEAREST);
+	_pChromeTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::NEAREST);
+	_pChromeTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+	_pChromeTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+	_pChromeTexture->setResizeNonPowerOfTwoHint(false);
+
+	// Create the render to texture camera
+	_pChromeCamera = new osg::Camera();
+	_pChromeCamera->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+	_pChromeCamera->setViewMatrix(osg::Matrix::identity());
+	_pChromeCamera->setClearColor(osg::Vec4(0.0, 0.0, 0.0, 0.0));
+	_pChromeCamera->setClearMask(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	_pChromeCamera->setRenderOrder(osg::Camera::PRE_RENDER);
+	_pChromeCamera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+	_pChromeCamera->attach(osg::Camera::COLOR_BUFFER, _pChromeTexture.get());
+
+	// Store premultiplied alpha, so glyph edges keep their coverage once
+	_pChromeCamera->getOrCreateStateSet()->setAttributeAndModes(
+		new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA),
+		osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+
+	_pChromeTransform = new osg::MatrixTransform();
+	_pChromeTransform->setDataVariance( osg::Object::DYNAMIC );
+	_pChromeCamera->addChild(_pChromeTransform.get());
+
+	// Only traverse the camera when the chrome changed
+	_pChromeGroup = new osg::Group();
+	_pChromeGroup->setCullingActive(false);
+	_pChromeGroup->setCullCallback(new ChromeCullCallback(this));
+	_pChromeGroup->addChild(_pChromeCamera.get());
+
+	// Create the quad compositing the cached chrome under the data
+	osg::ref_ptr<osg::Geometry> pRectangle = new osg::Geometry();
+	pRectangle->setDataVariance( osg::Object::DYNAMIC );
+	pRectangle->setVertexArray( new osg::Vec3Array(4) );
+
+	osg::ref_ptr<osg::Vec2Array> pTextureCoords = new osg::Vec2Array(4);
+	pTextureCoords->at(0).set(0.0, 0.0);
+	pTextureCoords->at(1).set(1.0, 0.0);
+	pTextureCoords->at(2).set(1.0, 1.0);
+	pTextureCoords->at(3).set(0.0, 1.0);
+	pRectangle->setTexCoordArray(0, pTextureCoords.get());
+
+	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
+	pColors->push_back(osg::Vec4(1.0, 1.0, 1.0, 1.0));
+	pRectangle->setColorArray( pColors.get() );
+	pRectangle->setColorBinding( osg::Geometry::BIND_OVERALL );
+	pRectangle->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( pRectangle.get() );
+
+	_pChromeGeode = new osg::Geode();
+	_pChromeGeode->addDrawable( pRectangle.get() );
+
+	osg::ref_ptr<osg::StateSet> stateset = _pChromeGeode->getOrCreateStateSet();
+	Shaders::setTexture(stateset.get(), _pChromeTexture.get());
+	// Composite premultiplied, so the cleared margins leave the window as is
+	stateset->setAttributeAndModes( new osg::BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA), osg::StateAttribute::ON );
+	stateset->setRenderBinDetails(-1, "RenderBin");
+}
+
+void osgtools::Plot::updateChromeCache()
+{
+	if (!_pChromeCamera.valid())
+		return;
+
+	// Resize the render target
+	_pChromeTexture->setTextureSize(_width, _height);
+	_pChromeTexture->dirtyTextureObject();
+	_pChromeCamera->setProjectionMatrix(osg::Matrix::ortho2D(0,_width,0,_height));
+	_pChromeCamera->setViewport(0,0,_width,_height);
+	_pChromeCamera->setRenderingCache(0);
+	Shaders::setViewport(_pChromeCamera->getOrCreateStateSet(), _width, _height);
+	_pChromeTransform->setMatrix( _pPlotTransform->getMatrix() );
+
+	// Cover the viewport with the cached chrome
+	osg::Geometry* pRectangle = _pChromeGeode->getDrawable(0)->asGeometry();
+	osg::Vec3Array* pVertices = dynamic_cast<osg::Vec3Array*>( pRectangle->getVertexArray() );
+	(*pVertices)[0].set(0, 0, BACKGROUND_Z);
+	(*pVertices)[1].set(_width, 0, BACKGROUND_Z);
+	(*pVertices)[2].set(_width, _height, BACKGROUND_Z);
+	(*pVertices)[3].set(0, _height, BACKGROUND_Z);
+	pVertices->dirty();
+	pRectangle->dirtyBound();
+}
+
+void osgtools::Plot::setChromeCaching( bool bCaching )
+{
+	if (!_bInitialized || bCaching == _bChromeCaching || (bCaching && _bTile))
+		return;
+	_bChromeCaching = bCaching;
+
+	if (_bChromeCaching) {
+		if (!_pChromeGroup.valid())
+			createChromeCache();
+
+		// Move the chrome into the render to texture camera
+		_pPlotTransform->removeChild( _pPlotGeode.get() );
+		removeChild( _pAxisGeode.get() );
+		_pChromeTransform->addChild( _pPlotGeode.get() );
+		_pChromeCamera->addChild( _pAxisGeode.get() );
+		addChild( _pChromeGroup.get() );
+		addChild( _pChromeGeode.get() );
+		updateChromeCache();
+	}
+	else {
+		// Draw the chrome directly again
+		removeChild( _pChromeGroup.get() );
+		removeChild( _pChromeGeode.get() );
+		_pChromeTransform->removeChild( _pPlotGeode.get() );
+		_pChromeCamera->removeChild( _pAxisGeode.get() );
+		_pPlotTransform->insertChild( 0, _pPlotGeode.get() );
+		addChild( _pAxisGeode.get() );
+	}
+
+	dirtyLayout();
+}
+
+void osgtools::Plot::setChromeLinesVisible( bool bVisible )
+{
+	if (!_bInitialized)
+		return;
+
+	_pPlotGeode->setNodeMask( bVisible ? ~0u : 0u );
+	if (bVisible && !_pAxisGeode->containsDrawable( _pTickLinesGeo.get() ))
+		_pAxisGeode->addDrawable( _pTickLinesGeo.get() );
+	else if (!bVisible)
+		_pAxisGeode->removeDrawable( _pTickLinesGeo.get() );
+}
+
+void osgtools::Plot::setTile( int x, int y, int width, int height )
+{
+	if (!_bTile) {
+		// Draw inside the dashboard pass, which draws the lines of all tiles
+		setChromeCaching(false);
+		_bTile = true;
+		setRenderOrder(osg::Camera::NESTED_RENDER);
+		setChromeLinesVisible(false);
+	}
+
+	_windowOffset[0] = x;
+	_windowOffset[1] = y;
+	resize(width, height);
+}
+
+void osgtools::Plot::clearTile()
+{
+	if (!_bTile)
+		return;
+
+	_bTile = false;
+	setRenderOrder(osg::Camera::POST_RENDER);
+	setChromeLinesVisible(true);
+	_windowOffset[0] = _windowOffset[1] = 0;
+	resize(_width, _height);
+}
+
+void osgtools::Plot::appendChrome( int x, int y, PlotChrome& chrome )
+{
+	const int* dim = _plotDim;
+	osg::Vec3 offset(x, y, 0);
+
+	// Background, as two triangles
+	osg::Vec3 corners[4] = {
+		osg::Vec3(dim[0], dim[1], BACKGROUND_Z),
+		osg::Vec3(dim[0] + dim[2], dim[1], BACKGROUND_Z),
+		osg::Vec3(dim[0] + dim[2], dim[1] + dim[3], BACKGROUND_Z),
+		osg::Vec3(dim[0], dim[1] + dim[3], BACKGROUND_Z)
+	};
+	static const int TRIANGLES[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i=0; i < 6; i++)
+		chrome.backgrounds->push_back(corners[TRIANGLES[i]] + offset);
+	chrome.backgroundColors->resize(chrome.backgrounds->size(), BACKGROUND_COLOR);
+
+	// Grid lines across the plot area, tick marks below and left of it
+	size_t minorStart = chrome.minorLines->size();
+	size_t majorStart = chrome.majorLines->size();
+	for (int axis=0; axis < 2; axis++) {
+		int from = dim[1 - axis];
+		int to = dim[1 - axis] + dim[3 - axis];
+
+		computeTicks(axis, _minorAxisGrid[axis], dim, _ticks, true);
+		appendAxisLines(axis, _ticks, from, to, chrome.minorLines->asVector());
+
+		computeTicks(axis, _majorAxisGrid[axis], dim, _ticks);
+		appendAxisLines(axis, _ticks, from, to, chrome.majorLines->asVector());
+		chrome.majorColors->resize(chrome.majorLines->size(), GRID_COLOR);
+		appendAxisLines(axis, _ticks, from, from - TICK_LENGTH, chrome.majorLines->asVector());
+		chrome.majorColors->resize(chrome.majorLines->size(), TICK_COLOR);
+	}
+	chrome.minorColors->resize(chrome.minorLines->size(), GRID_COLOR);
+	chrome.minorWidth = MINOR_GRID_WIDTH;
+	chrome.majorWidth = std::max(MAJOR_GRID_WIDTH, TICK_WIDTH);
+
+	// Move the lines to the offset
+	for (size_t i=minorStart; i < chrome.minorLines->size(); i++)
+		(*chrome.minorLines)[i] += offset;
+	for (size_t i=majorStart; i < chrome.majorLines->size(); i++)
+		(*chrome.majorLines)[i] += offset;
+}
+
+bool osgtools::Plot::addPlotChild( osg::Node* pNode )
+{
+	if (!_pPlotTransform.valid())
+		return false;
+	return _pDataTransform->addChild( pNode );
+}
+
+void osgtools::Plot::computeLayout( PlotLayout& layout ) const
+{
+	layout.width = _width;
+	layout.height = _height;
+	memcpy(layout.plotDim,_plotDim,sizeof(int)*4);
+
+	for (int axis=0; axis < 2; axis++) {
+		computeTicks(axis, _majorAxisGrid[axis], _plotDim, layout.majorTicks[axis]);
+		computeTicks(axis, _minorAxisGrid[axis], _plotDim, layout.minorTicks[axis], true);
+		layout.tickLabels[axis].resize(computeTickLabels(axis, layout.majorTicks[axis], layout.tickLabels[axis]));
+		computeTitle(axis, layout.titles[axis]);
+	}
+}
+
+bool osgtools::Plot::drawVector( VectorCanvas& canvas )
+{
+	if (!_bInitialized)
+		return false;
+
+	PlotLayout layout;
+	computeLayout(layout);
+	const int* dim = layout.plotDim;
+	std::vector<osg::Vec3> lines;
+
+	canvas.begin(layout.width, layout.height);
+
+	// Background
+	canvas.rect(dim[0], dim[1], dim[0] + dim[2], dim[1] + dim[3], BACKGROUND_COLOR, BACKGROUND_COLOR);
+
+	// Grid lines, major over minor
+	appendAxisLines(0, layout.minorTicks[0], dim[1], dim[1] + dim[3], lines);
+	appendAxisLines(1, layout.minorTicks[1], dim[0], dim[0] + dim[2], lines);
+	for (int i=0; i+1 < lines.size(); i += 2)
+		canvas.line(lines[i].x(), lines[i].y(), lines[i+1].x(), lines[i+1].y(), MINOR_GRID_WIDTH, GRID_COLOR);
+	lines.clear();
+	appendAxisLines(0, layout.majorTicks[0], dim[1], dim[1] + dim[3], lines);
+	appendAxisLines(1, layout.majorTicks[1], dim[0], dim[0] + dim[2], lines);
+	for (int i=0; i+1 < lines.size(); i += 2)
+		canvas.line(lines[i].x(), lines[i].y(), lines[i+1].x(), lines[i+1].y(), MAJOR_GRID_WIDTH, GRID_COLOR);
+
+	// Subclass data
+	drawVectorData(canvas);
+
+	// Tick marks
+	lines.clear();
+	appendAxisLines(0, layout.majorTicks[0], dim[1], dim[1] - TICK_LENGTH, lines);
+	appendAxisLines(1, layout.majorTicks[1], dim[0], dim[0] - TICK_LENGTH, lines);
+	for (int i=0; i+1 < lines.size(); i += 2)
+		canvas.line(lines[i].x(), lines[i].y(), lines[i+1].x(), lines[i+1].y(), TICK_WIDTH, TICK_COLOR);
+
+	// Labels
+	for (int axis=0; axis < 2; axis++) {
+		const PlotLabel& title = layout.titles[axis];
+		canvas.text(title.text, title.position.x(), title.position.y(), title.size, title.bRotated, TEXT_COLOR);
+		for (int i=0; i < layout.tickLabels[axis].size(); i++) {
+			const PlotLabel& label = layout.tickLabels[axis][i];
+			canvas.text(label.text, label.position.x(), label.position.y(), label.size, label.bRotated, TEXT_COLOR);
+		}
+	}
+
+	return canvas.end();
+}
+
+bool osgtools::Plot::writeSVG( std::ostream& out )
+{
+	SvgCanvas canvas(out);
+	return drawVector(canvas);
+}
+
+bool osgtools::Plot::writePDF( std::ostream& out )
+{
+	PdfCanvas canvas(out);
+	return drawVector(canvas);
+}
+
+bool osgtools::Plot::writeVectorFile( const std::string& path )
+{
+	std::string::size_type dot = path.find_last_of('.');
+	if (dot == std::string::npos)
+		return false;
+	std::string ext = path.substr(dot + 1);
+	for (int i=0; i < ext.size(); i++)
+		ext[i] = tolower(ext[i]);
+	if (ext != "svg" && ext != "pdf")
+		return false;
+
+	std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+	if (!out.is_open())
+		return false;
+
+	return (ext == "svg" ? writeSVG(out) : writePDF(out));
 }
 
 int osgtools::Plot::getXValuePixel( float x )
 {
-	if (x < _range[0] || x > _range[2])
-		return -1;
-	float xVal = x - _range[0];
-	float pxPerUnit = (float)_plotDim[2]/(_range[2] - _range[0]);
-	return _plotDim[0] + (xVal * pxPerUnit);
+	return getValuePixel(0, x, _plotDim);
 }
 
 int osgtools::Plot::getYValuePixel( float y )
 {
-	if (y < _range[1] || y > _range[3])
-		return -1;
-	float yVal = y - _range[1];
-	float pxPerUnit = (float)_plotDim[3]/(_range[3] - _range[1]);
-	return _plotDim[1] + (yVal * pxPerUnit);
+	return getValuePixel(1, y, _plotDim);
+}
+
+std::string osgtools::Plot::getPickText( const PlotPick& pick )
+{
+	char s[64];
+	snprintf(s, sizeof(s), "%g, %g: %g", pick.x, pick.y, pick.value);
+	return s;
+}
+
+float osgtools::Plot::getXPixelValue( float x )
+{
+	double t = (_plotDim[2] > 0 ? (x - _plotDim[0]) / _plotDim[2] : 0.0);
+	return _scales[0]->inverse(_scaledRange[0] + t * (_scaledRange[2] - _scaledRange[0]));
+}
+
+float osgtools::Plot::getYPixelValue( float y )
+{
+	double t = (_plotDim[3] > 0 ? (y - _plotDim[1]) / _plotDim[3] : 0.0);
+	return _scales[1]->inverse(_scaledRange[1] + t * (_scaledRange[3] - _scaledRange[1]));
+}
+
+int osgtools::Plot::getXLayoutPixel( float x )
+{
+	return getValuePixel(0, x, _layoutDim);
+}
+
+int osgtools::Plot::getYLayoutPixel( float y )
+{
+	return getValuePixel(1, y, _layoutDim);
 }
 
 void osgtools::Plot::getRange( float& xmin, float& ymin, float& xmax, float& ymax )
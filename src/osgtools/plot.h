@@ -9,21 +9,115 @@
 #pragma once
 
 // STL
+#include <ostream>
 #include <string>
+#include <vector>
 
 // OSG
 #include <osg/Camera>
 #include <osg/Geometry>
 #include <osg/Geode>
-#include <osg/LineWidth>
+#include <osg/MatrixTransform>
+#include <osg/Texture2D>
+#include <osg/buffered_value>
 #include <osg/ref_ptr>
 #include <osgText/Text>
 
 // Local
 #include "osgtools.h"
+#include "axisscale.h"
+#include "buildstats.h"
+#include "ticks.h"
+#include "vectorcanvas.h"
 
 namespace osgtools {
 
+	/*!
+	 *	An item of a plot found at a pixel
+	 */
+	struct PlotPick {
+		int series;		/*!< Series of the item, 0 for single series plots */
+		int index;		/*!< Index of the item in its series (bin, point or column) */
+		int row;		/*!< Row of a heatmap cell, -1 otherwise */
+		float x;		/*!< Position of the item in plot coordinates */
+		float y;
+		float value;	/*!< Value of the item */
+
+		PlotPick() : series(-1), index(-1), row(-1), x(0), y(0), value(0) {}
+	};
+
+	/*!
+	 *	A grid value and its pixel along an axis
+	 */
+	struct PlotTick {
+		float value;
+		int pixel;
+	};
+
+	/*!
+	 *	A label string and where it is drawn
+	 */
+	struct PlotLabel {
+		std::string text;
+		osg::Vec3 position;							/*!<	Start of the baseline in pixels */
+		float size;									/*!<	Character size in pixels */
+		float width;								/*!<	Advance of the text in pixels */
+		bool bRotated;								/*!<	Runs upwards instead of to the right */
+	};
+
+	/*!
+	 *	Everything needed to draw the plot chrome at the current size. Both
+	 *	the scene graph and the vector output are built from this, so they
+	 *	always match. Arrays are indexed by axis (0 = x, 1 = y).
+	 */
+	struct PlotLayout {
+		int width;
+		int height;
+		int plotDim[4];								/*!<	Plot area: (start x, start y, width x, height y) */
+		std::vector<PlotTick> majorTicks[2];
+		std::vector<PlotTick> minorTicks[2];
+		std::vector<PlotLabel> tickLabels[2];
+		PlotLabel titles[2];
+	};
+
+	/*!
+	 *	Shared arrays the chrome of several plots is appended to, so it
+	 *	can be drawn by three drawables however many plots there are
+	 */
+	struct PlotChrome {
+		osg::ref_ptr<osg::Vec3Array> backgrounds;	/*!<	Triangles of the plot area backgrounds */
+		osg::ref_ptr<osg::Vec4Array> backgroundColors;
+		osg::ref_ptr<osg::Vec3Array> minorLines;	/*!<	Vertex pairs of the minor grid lines */
+		osg::ref_ptr<osg::Vec4Array> minorColors;
+		osg::ref_ptr<osg::Vec3Array> majorLines;	/*!<	Vertex pairs of the major grid lines and tick marks */
+		osg::ref_ptr<osg::Vec4Array> majorColors;
+		float minorWidth;							/*!<	Line widths, set by Plot::appendChrome */
+		float majorWidth;
+
+		PlotChrome() :
+			backgrounds(new osg::Vec3Array()),
+			backgroundColors(new osg::Vec4Array()),
+			minorLines(new osg::Vec3Array()),
+			minorColors(new osg::Vec4Array()),
+			majorLines(new osg::Vec3Array()),
+			majorColors(new osg::Vec4Array()),
+			minorWidth(1),
+			majorWidth(1)
+		{}
+
+		/*!
+		 *	Empties the arrays, keeping their storage
+		 */
+		void clear() {
+			backgrounds->clear();
+			backgroundColors->clear();
+			minorLines->clear();
+			minorColors->clear();
+			majorLines->clear();
+			majorColors->clear();
+		}
+	};
+
 	class OSGTOOLS Plot : public osg::Camera {
 
 	protected:
@@ -32,8 +126,16 @@ namespace osgtools {
 		int _height;
 
 		bool _bInitialized;
-
-		int _range[4];								/*!<	Cartesian plot range: (-x, -y, +x, +y)	*/
+		bool _bNeedsRedraw;							/*!<	Set when the plot changed since the last frame */
+		bool _bChromeCaching;						/*!<	Chrome is rendered into a cached texture */
+		osg::buffered_value<bool> _chromeCached;	/*!<	Set per context once the cached chrome is rendered */
+		bool _bTile;								/*!<	Drawn as a tile inside a Dashboard pass */
+		int _windowOffset[2];						/*!<	Origin of the plot in the window of its Dashboard */
+		unsigned int _numLayouts;					/*!<	Counts layout changes, so a Dashboard can follow them */
+
+		float _range[4];							/*!<	Cartesian plot range: (-x, -y, +x, +y)	*/
+		double _scaledRange[4];						/*!<	The range in the scale space of each axis */
+		osg::ref_ptr<AxisScale> _scales[2];			/*!<	Scales of the x and y axes */
 		float _majorAxisGrid[2];
 		float _minorAxisGrid[2];
 
@@ -43,9 +145,15 @@ namespace osgtools {
 		std::vector< std::string > _xLabels;
 		std::vector< std::string > _yLabels;
 
-		osg::ref_ptr<osg::Geode> _pPlotGeode;
+		osg::ref_ptr<osg::MatrixTransform> _pPlotTransform;	/*!<	Maps geometry built at _layoutDim onto _plotDim */
+		osg::ref_ptr<osg::MatrixTransform> _pDataTransform;	/*!<	Maps data built at _dataRange onto the current range */
+		double _dataRange[4];								/*!<	Scaled range the data geometry was built against */
+		bool _bViewLayoutDirty;								/*!<	Set when the grid and labels lag the view range */
+		osg::ref_ptr<osg::Geode> _pPlotGeode;				/*!<	Plot area drawables (background, grid lines) */
+		osg::ref_ptr<osg::Geode> _pAxisGeode;				/*!<	Axis drawables (tick marks, labels) */
 
 		int _plotDim[4];							/*!<	Plot dimensions in pixels: (start x, start y, width x, height y) */
+		int _layoutDim[4];							/*!<	Plot dimensions the plot area geometry was built against */
 
 		// Drawables
 		osg::ref_ptr<osg::Geometry> _pBackgroundGeo;
@@ -56,6 +164,20 @@ namespace osgtools {
 		osg::ref_ptr<osg::Geometry> _pTickLinesGeo;
 		std::vector<osg::ref_ptr<osgText::Text>> _xLabelsGeo;
 		std::vector<osg::ref_ptr<osgText::Text>> _yLabelsGeo;
+
+		// Chrome cache
+		class ChromeCullCallback;
+		osg::ref_ptr<osg::Group> _pChromeGroup;				/*!<	Culls the chrome camera only when the chrome changed */
+		osg::ref_ptr<osg::Camera> _pChromeCamera;			/*!<	Renders the chrome into _pChromeTexture */
+		osg::ref_ptr<osg::MatrixTransform> _pChromeTransform;	/*!<	Plot area transform inside the chrome camera */
+		osg::ref_ptr<osg::Texture2D> _pChromeTexture;		/*!<	Cached background, grid, ticks and labels */
+		osg::ref_ptr<osg::Geode> _pChromeGeode;				/*!<	Quad compositing the cached chrome */
+
+		std::vector<PlotTick> _ticks;				/*!<	Scratch ticks, kept so rebuilds reuse their storage */
+		std::vector<PlotLabel> _labels;				/*!<	Scratch labels, kept so rebuilds reuse their storage */
+		mutable std::vector<double> _tickValues;	/*!<	Scratch tick values, kept so rebuilds reuse their storage */
+
+		BuildStats _buildStats;						/*!<	Stats of the last rebuild (OSGTOOLS_ENABLE_STATS) */
 		
 
 		// Constants
@@ -68,16 +190,190 @@ namespace osgtools {
 		static const float MAJORMINORAXES_Z;
 		static const float TEXT_Z;
 
+		static const osg::Vec4 BACKGROUND_COLOR;
+		static const osg::Vec4 GRID_COLOR;
+		static const osg::Vec4 TICK_COLOR;
+		static const osg::Vec4 TEXT_COLOR;
+
+		static const float MAJOR_GRID_WIDTH;
+		static const float MINOR_GRID_WIDTH;
+		static const float TICK_WIDTH;
+		static const int TICK_LENGTH;
+		static const int MIN_TICK_SPACING;
+		static const int MAJOR_GRID_SPACING;
+
+		static const float TITLE_SIZE;
+		static const float TICK_LABEL_SIZE;
+		static const int LABEL_SPACING;				/*!<	Least gap between tick labels in pixels */
+
 		/*!
 		*	Initializes the plot
 		*/
 		void initialize();
 
+		/*!
+		 *	Computes the plot dimensions from the window size and labels
+		 */
+		void updatePlotDimensions();
+
+		/*!
+		 *	Updates the plot area transform to map _layoutDim onto _plotDim
+		 */
+		void updateLayoutTransform();
+
+		/*!
+		 *	Rebuilds the layout at the current plot dimensions. Geometry under
+		 *	the plot area transform must be rebuilt after calling this.
+		 */
+		void rebaseLayout();
+
+		/*!
+		 *	Repositions the tick marks and labels at the current plot dimensions
+		 */
+		void layoutAxes();
+
+		/*!
+		 *	Marks the layout as changed: the cached chrome is rendered again
+		 *	and the plot is redrawn
+		 */
+		void dirtyLayout();
+
+		/*!
+		 *	Creates the render to texture camera and quad for chrome caching
+		 */
+		void createChromeCache();
+
+		/*!
+		 *	Resizes the chrome cache to the plot dimensions
+		 */
+		void updateChromeCache();
+
+		/*!
+		 *	Shows or hides the background, grid lines and tick marks, which
+		 *	a Dashboard draws for its tiles
+		 */
+		void setChromeLinesVisible( bool bVisible );
+
+		/*!
+		 *	Gets the largest number of ticks along an axis, one per
+		 *	MIN_TICK_SPACING pixels of the layout. Finer grids are coarsened
+		 *	to fit, the same way for the grid lines and the labels.
+		 */
+		int getMaxTicks( int axis ) const;
+
+		/*!
+		 *	Gets a nice grid step (1, 2 or 5 times a power of ten, in the
+		 *	scale space of the axis) placing major grid lines about
+		 *	MAJOR_GRID_SPACING pixels apart
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	min		The start of the range along the axis
+		 *	\param	max		The end of the range along the axis
+		 */
+		float getNiceGrid( int axis, float min, float max ) const;
+
+		/*!
+		 *	Maps the range into the scale space of the axes
+		 */
+		void updateScaledRange();
+
+		/*!
+		 *	Maps the data geometry from the range it was built against onto
+		 *	the current range, and clips it to the plot area
+		 */
+		void updateDataTransform();
+
+		/*!
+		 *	Rebuilds the grid lines, tick marks and labels at the current range
+		 */
+		void updateAxes();
+
+		/*!
+		 *	Rebuilds the data geometry at the current range
+		 */
+		void redrawData();
+
+		/*!
+		 *	Gets the pixel of a value along an axis
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	value	The value
+		 *	\param	dim		The plot dimensions to map onto (_plotDim or _layoutDim)
+		 *	\return	The pixel, or -1 if the value is out of range
+		 */
+		int getValuePixel( int axis, float value, const int* dim ) const;
+
+		/*!
+		 *	Computes the grid values and their pixels along an axis
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	step	The step between grid values
+		 *	\param	dim		The plot dimensions to map onto
+		 *	\param	ticks	The ticks within the range
+		 *	\param	bMinor	True for the minor grid
+		 */
+		void computeTicks( int axis, float step, const int* dim, std::vector<PlotTick>& ticks, bool bMinor = false ) const;
+
+		/*!
+		 *	Computes the labels of the major ticks along an axis at the
+		 *	current plot dimensions, measured with the label font and culled
+		 *	so that none overlap (see cullTickLabels)
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	ticks	The major ticks of the axis
+		 *	\param	labels	The labels, at most one per tick. The vector only
+		 *					grows, so labels past the kept ones keep their
+		 *					storage for later rebuilds.
+		 *	\return	The number of labels kept, first in labels
+		 */
+		int computeTickLabels( int axis, const std::vector<PlotTick>& ticks, std::vector<PlotLabel>& labels ) const;
+
+		/*!
+		 *	Removes tick labels that would overlap. The labels are thinned to
+		 *	every 2^k-th major grid line, counted from zero so the labels kept
+		 *	stay put while panning, with k the lowest level at which no labels
+		 *	overlap. A sweep along the axis then drops any label still
+		 *	overlapping the one before it. The labels left fit the pixels of
+		 *	the axis, however dense the ticks.
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	ticks	The major ticks of the axis
+		 *	\param	labels	The labels, one per tick, culled in place
+		 *	\return	The number of labels kept, moved to the front
+		 */
+		int cullTickLabels( int axis, const std::vector<PlotTick>& ticks, std::vector<PlotLabel>& labels ) const;
+
+		/*!
+		 *	Computes the title of an axis at the current plot dimensions
+		 */
+		void computeTitle( int axis, PlotLabel& label ) const;
+
+		/*!
+		 *	Appends a line across the plot area for each tick, as vertex pairs
+		 *	\param	axis	The axis the ticks are on (0 = x, 1 = y)
+		 *	\param	ticks	The ticks
+		 *	\param	from	The start of the lines along the other axis
+		 *	\param	to		The end of the lines along the other axis
+		 *	\param	lines	The vertex pairs
+		 */
+		void appendAxisLines( int axis, const std::vector<PlotTick>& ticks, int from, int to, std::vector<osg::Vec3>& lines ) const;
+
+		/*!
+		 *	Creates a text drawable for a label
+		 */
+		osgText::Text* createLabelText( const PlotLabel& label );
+
+		/*!
+		 *	Updates a recycled text drawable to a label, touching only what
+		 *	changed
+		 */
+		void updateLabelText( osgText::Text* pText, const PlotLabel& label );
+
 		/*!
 		 *	Creates the background
 		 */
 		osg::Geometry* createBackground();
 
+		/*!
+		 *	Updates the background vertices to the layout dimensions
+		 */
+		void updateBackground();
+
 		/*!
 		 *	Creates the major axis grid lines
 		 */
@@ -88,6 +384,29 @@ namespace osgtools {
 		 */
 		osg::Geometry* createMinorAxisGridLines();
 
+		/*!
+		 *	Creates grid lines at the layout dimensions
+		 *	\param	grid	The grid step of each axis
+		 *	\param	width	The line width
+		 */
+		osg::Geometry* createGridLines( const float* grid, float width );
+
+		/*!
+		 *	Fills a vertex array with grid lines at the layout dimensions
+		 *	\param	pVertices	The vertex array to fill
+		 *	\param	grid		The grid step of each axis; _minorAxisGrid places
+		 *						the ticks of the minor grid
+		 */
+		void fillGridLines( osg::Vec3Array* pVertices, const float* grid );
+
+		/*!
+		 *	Refills grid or tick lines in place. The vertex array keeps its
+		 *	storage, so nothing is allocated once it is large enough.
+		 *	\param	pLines	The lines to refill
+		 *	\param	grid	The grid step of each axis, or 0 for the tick marks
+		 */
+		void updateLines( osg::Geometry* pLines, const float* grid );
+
 		/*!
 		 *	Create the x axis label
 		 */
@@ -103,6 +422,22 @@ namespace osgtools {
 		 */
 		osg::Geometry* createTickMarks();
 
+		/*!
+		 *	Fills a vertex array with the tick mark lines
+		 *	\param	pVertices	The vertex array to fill
+		 */
+		void fillTickMarks( osg::Vec3Array* pVertices );
+
+		/*!
+		 *	Positions the x axis label
+		 */
+		void positionXLabel( osgText::Text* pLabel );
+
+		/*!
+		 *	Positions the y axis label
+		 */
+		void positionYLabel( osgText::Text* pLabel );
+
 		/*!
 		 *	Create the labels for the x axis
 		 */
@@ -128,12 +463,38 @@ namespace osgtools {
 		 */
 		void setMinorAxisGrid( float xGrid, float yGrid );
 
+		/*!
+		 *	Adds a node to the plot area. Nodes added here are built in layout
+		 *	pixels (see getXLayoutPixel) at the current range, rescaled when the
+		 *	plot is resized and moved with setViewRange.
+		 *	\param	pNode	The node to add
+		 */
+		bool addPlotChild( osg::Node* pNode );
+
+		/*!
+		 *	Get layout pixel for x value
+		 */
+		int getXLayoutPixel( float x );
+
+		/*!
+		 *	Get layout pixel for y value
+		 */
+		int getYLayoutPixel( float y );
+
+		/*!
+		 *	Draws the data between the grid and the axes of the vector output.
+		 *	Subclasses draw at _plotDim here what redraw() builds.
+		 */
+		virtual void drawVectorData( VectorCanvas& canvas ) {}
+
 	public:
 		Plot();
 		Plot( int width, int height, std::string xLabel="", std::string yLabel="" );
 
 		/*!
-		*	Resizes the pixel dimensions of the plot
+		*	Resizes the pixel dimensions of the plot. The plot area is rescaled
+		*	through its transform and the axes are repositioned; no geometry is
+		*	rebuilt until the next change of range.
 		*	\param	width	The width in pixels of the plot
 		*	\param	height	The height in pixels of the plot
 		*/
@@ -192,6 +553,16 @@ namespace osgtools {
 		 */
 		int getYValuePixel( float y );
 
+		/*!
+		 *	Get x value at a pixel
+		 */
+		float getXPixelValue( float x );
+
+		/*!
+		 *	Get y value at a pixel
+		 */
+		float getYPixelValue( float y );
+
 
 		/// Setters
 		/*!
@@ -215,22 +586,179 @@ namespace osgtools {
 		*/
 		void setRange( float xmin, float ymin, float xmax, float ymax );
 
+		/*!
+		 *	Moves the view to a range without rebuilding the data. The data
+		 *	geometry is transformed onto the new range and clipped to the plot
+		 *	area; the grid and labels follow on updateViewLayout(). Call
+		 *	setRange() with the final range to rebuild the data at it.
+		 *	\param	xmin	The minimum x value
+		 *	\param	ymin	The minimum y value
+		 *	\param	xmax	The maximum x value
+		 *	\param	ymax	The maximum y value
+		 */
+		void setViewRange( float xmin, float ymin, float xmax, float ymax );
+
+		/*!
+		 *	Finds the item at a pixel from the data, without intersecting
+		 *	the geometry
+		 *	\param	x		The x pixel in the plot
+		 *	\param	y		The y pixel in the plot
+		 *	\param	pick	The item
+		 *	\return	True if an item is at the pixel
+		 */
+		virtual bool pick( float x, float y, PlotPick& pick ) { return false; }
+
+		/*!
+		 *	Formats a pick for a tooltip
+		 */
+		virtual std::string getPickText( const PlotPick& pick );
+
+		/*!
+		 *	Lays out the grid and labels at the view range, if it changed
+		 *	since the last layout
+		 */
+		void updateViewLayout();
+
+		/*!
+		 *	Gets whether the grid and labels lag the view range
+		 */
+		bool isViewLayoutDirty() { return _bViewLayoutDirty; }
+
+		/*!
+		 *	Sets the scale of an axis. Grid steps of the axis are then given
+		 *	in its scale space, e.g. in decades for a LogScale.
+		 *	\param	axis	The axis (0 = x, 1 = y)
+		 *	\param	pScale	The scale, or 0 for a linear axis
+		 */
+		void setAxisScale( int axis, AxisScale* pScale );
+
+		/*!
+		 *	Gets the scale of an axis
+		 */
+		AxisScale* getAxisScale( int axis ) { return _scales[axis].get(); }
+
 		/*!
 		 *	Set the x axis label
 		 *	\param	xLabel	The x axis label
 		 */
-		void setXLabel( std::string& xLabel ) { _xLabel = xLabel; }
+		void setXLabel( std::string& xLabel );
 
 		/*!
 		 *	Set the y axis label
 		 *	\param	yLabel	The y axis label
 		 */
-		void setYLabel( std::string& yLabel ) { _yLabel = yLabel; }
+		void setYLabel( std::string& yLabel );
+
+		/*!
+		 *	Renders the background, grid, ticks and labels once into a texture
+		 *	that is composited under the data each frame. The texture is only
+		 *	rendered again when the layout changes. The cache is shared by all
+		 *	views, so use it with a single view. Not available for tiles.
+		 *	\param	bCaching	True to cache the chrome
+		 */
+		void setChromeCaching( bool bCaching );
+
+		/*!
+		 *	Gets whether the chrome is cached
+		 */
+		bool getChromeCaching() { return _bChromeCaching; }
+
+		/*!
+		 *	Makes the plot a tile of a Dashboard. The plot is drawn within the
+		 *	dashboard's pass at (x, y) of its window, without a clear or a
+		 *	render stage of its own, and leaves its background, grid lines
+		 *	and tick marks to the dashboard (see appendChrome).
+		 *	\param	x		The left pixel of the tile in the window
+		 *	\param	y		The bottom pixel of the tile in the window
+		 *	\param	width	The width of the tile in pixels
+		 *	\param	height	The height of the tile in pixels
+		 */
+		void setTile( int x, int y, int width, int height );
+
+		/*!
+		 *	Makes a tile a standalone plot again, drawn at the window origin
+		 */
+		void clearTile();
+
+		/*!
+		 *	Gets whether the plot is a tile of a Dashboard
+		 */
+		bool isTile() { return _bTile; }
+
+		/*!
+		 *	Gets the number of layout changes so far. The chrome built by
+		 *	appendChrome is stale once this changes.
+		 */
+		unsigned int getNumLayouts() { return _numLayouts; }
+
+		/*!
+		 *	Appends the background, grid lines and tick marks at the current
+		 *	size to shared arrays, moved by an offset. A Dashboard draws the
+		 *	chrome of all its tiles from the same arrays.
+		 *	\param	x		The offset of the plot in pixels
+		 *	\param	y
+		 *	\param	chrome	The arrays to append to
+		 */
+		void appendChrome( int x, int y, PlotChrome& chrome );
+
+		/*!
+		 *	Computes the layout of the plot chrome at the current size
+		 *	\param	layout	The layout
+		 */
+		void computeLayout( PlotLayout& layout ) const;
+
+		/*!
+		 *	Draws the plot onto a vector canvas. No GL context is needed, and
+		 *	several plots can be drawn at once on different threads.
+		 *	\param	canvas	The canvas to draw on
+		 *	\return	True if the canvas was written
+		 */
+		bool drawVector( VectorCanvas& canvas );
+
+		/*!
+		 *	Writes the plot as SVG
+		 */
+		bool writeSVG( std::ostream& out );
+
+		/*!
+		 *	Writes the plot as PDF
+		 */
+		bool writePDF( std::ostream& out );
+
+		/*!
+		 *	Writes the plot to a .svg or .pdf file
+		 *	\param	path	The file to write
+		 *	\return	True if the file was written
+		 */
+		bool writeVectorFile( const std::string& path );
 
 		/*!
 		 *	Redraw function for subclasses
 		 */
 		virtual void redraw() {}
 
+		/*!
+		 *	Marks the plot as changed so the next frame is drawn
+		 */
+		void dirtyRedraw() { _bNeedsRedraw = true; }
+
+		/*!
+		 *	Gets whether the plot changed since the last frame. Set only by
+		 *	data, range, label and size changes.
+		 *	\return	True if the plot needs to be drawn
+		 */
+		bool needsRedraw() { return _bNeedsRedraw; }
+
+		/*!
+		 *	Clears the redraw flag once a frame has been drawn
+		 */
+		void clearRedraw() { _bNeedsRedraw = false; }
+
+		/*!
+		 *	Gets the stats of the last rebuild. The counters stay zero unless
+		 *	the library is built with OSGTOOLS_ENABLE_STATS.
+		 */
+		const BuildStats& getBuildStats() { return _buildStats; }
+
 	};
 }
\ No newline at end of file
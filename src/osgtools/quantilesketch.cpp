@@ -0,0 +1,193 @@
+/*
+	quantilesketch.cpp
+	Mergeable streaming histogram of unbounded values
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "quantilesketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const double osgtools::QuantileSketch::MIN_VALUE = 1e-30;
+
+void osgtools::QuantileSketch::Store::add( int index, double count, int maxBuckets )
+{
+	if (counts.empty()) {
+		offset = index;
+		counts.push_back(0.0);
+	}
+
+	// Keep the top buckets, merging the lowest ones past the limit
+	int top = std::max(offset + (int)counts.size() - 1, index);
+	int bottom = std::max(std::min(offset, index), top - maxBuckets + 1);
+	counts.resize(top - offset + 1, 0.0);
+	if (bottom < offset) {
+		counts.insert(counts.begin(), offset - bottom, 0.0);
+		offset = bottom;
+	}
+	else if (bottom > offset) {
+		double merged = 0;
+		for (int i=0; i < bottom - offset; i++)
+			merged += counts[i];
+		counts.erase(counts.begin(), counts.begin() + (bottom - offset));
+		counts[0] += merged;
+		offset = bottom;
+	}
+
+	counts[std::max(index, offset) - offset] += count;
+}
+
+osgtools::QuantileSketch::QuantileSketch( double relativeAccuracy, int maxBuckets ) :
+	_relativeAccuracy(relativeAccuracy),
+	_gamma((1 + relativeAccuracy) / (1 - relativeAccuracy)),
+	_logGamma(std::log(_gamma)),
+	_maxBuckets(std::max(maxBuckets, 1))
+{
+	clear();
+}
+
+int osgtools::QuantileSketch::getIndex( double value ) const
+{
+	return (int)std::ceil(std::log(value) / _logGamma);
+}
+
+void osgtools::QuantileSketch::getBucketBounds( int index, double& lower, double& upper ) const
+{
+	upper = std::exp(index * _logGamma);
+	lower = upper / _gamma;
+}
+
+void osgtools::QuantileSketch::add( double value, double count )
+{
+	if (!(count > 0) || !std::isfinite(value))
+		return;
+
+	if (value > MIN_VALUE)
+		_positive.add(getIndex(value), count, _maxBuckets);
+	else if (value < -MIN_VALUE)
+		_negative.add(getIndex(-value), count, _maxBuckets);
+	else
+		_zeroCount += count;
+
+	if (_count == 0) {
+		_min = _max = value;
+	}
+	else {
+		_min = std::min(_min, value);
+		_max = std::max(_max, value);
+	}
+	_count += count;
+}
+
+bool osgtools::QuantileSketch::merge( const QuantileSketch& sketch )
+{
+	if (sketch._gamma != _gamma)
+		return false;
+	if (sketch._count == 0)
+		return true;
+
+	for (int i=0; i < sketch._positive.counts.size(); i++) {
+		if (sketch._positive.counts[i] > 0)
+			_positive.add(sketch._positive.offset + i, sketch._positive.counts[i], _maxBuckets);
+	}
+	for (int i=0; i < sketch._negative.counts.size(); i++) {
+		if (sketch._negative.counts[i] > 0)
+			_negative.add(sketch._negative.offset + i, sketch._negative.counts[i], _maxBuckets);
+	}
+	_zeroCount += sketch._zeroCount;
+
+	_min = (_count == 0 ? sketch._min : std::min(_min, sketch._min));
+	_max = (_count == 0 ? sketch._max : std::max(_max, sketch._max));
+	_count += sketch._count;
+	return true;
+}
+
+void osgtools::QuantileSketch::clear()
+{
+	_positive.counts.clear();
+	_negative.counts.clear();
+	_zeroCount = 0;
+	_count = 0;
+	_min = _max = 0;
+}
+
+double osgtools::QuantileSketch::getQuantile( double q ) const
+{
+	if (_count == 0)
+		return 0;
+
+	// Walk the buckets from the lowest value up to the rank
+	double rank = std::min(std::max(q, 0.0), 1.0) * (_count - 1);
+	double value = 0, total = 0;
+	bool bFound = false;
+	for (int i=(int)_negative.counts.size() - 1; i >= 0 && !bFound; i--) {
+		total += _negative.counts[i];
+		if (total > rank) {
+			value = -2 * std::exp((_negative.offset + i) * _logGamma) / (_gamma + 1);
+			bFound = true;
+		}
+	}
+	if (!bFound) {
+		total += _zeroCount;
+		bFound = (total > rank);
+	}
+	for (int i=0; i < _positive.counts.size() && !bFound; i++) {
+		total += _positive.counts[i];
+		if (total > rank) {
+			value = 2 * std::exp((_positive.offset + i) * _logGamma) / (_gamma + 1);
+			bFound = true;
+		}
+	}
+
+	// The bucket estimate can pass the extremes
+	return std::min(std::max(value, _min), _max);
+}
+
+void osgtools::QuantileSketch::addToBins( double lower, double upper, double count, const std::vector<float>& edges, std::vector<float>& bins ) const
+{
+	// First bin reaching past the lower bound
+	int bin = std::upper_bound(edges.begin(), edges.end(), (float)lower) - edges.begin() - 1;
+	if (upper <= lower) {
+		if (bin >= 0 && bin < bins.size())
+			bins[bin] += count;
+		else if (lower == edges.back())
+			bins.back() += count;
+		return;
+	}
+
+	bin = std::max(bin, 0);
+	double density = count / (upper - lower);
+	for (; bin < bins.size() && edges[bin] < upper; bin++) {
+		double overlap = std::min(upper, (double)edges[bin + 1]) - std::max(lower, (double)edges[bin]);
+		if (overlap > 0)
+			bins[bin] += density * overlap;
+	}
+}
+
+void osgtools::QuantileSketch::getBins( const std::vector<float>& edges, std::vector<float>& bins ) const
+{
+	bins.assign(std::max((int)edges.size() - 1, 0), 0.0f);
+	if (bins.empty() || _count == 0)
+		return;
+
+	// Clamp the buckets to the extremes, so a narrow distribution stays narrow
+	double lower, upper;
+	for (int i=0; i < _negative.counts.size(); i++) {
+		if (_negative.counts[i] == 0)
+			continue;
+		getBucketBounds(_negative.offset + i, lower, upper);
+		addToBins(std::max(-upper, _min), std::min(-lower, _max), _negative.counts[i], edges, bins);
+	}
+	if (_zeroCount > 0)
+		addToBins(0, 0, _zeroCount, edges, bins);
+	for (int i=0; i < _positive.counts.size(); i++) {
+		if (_positive.counts[i] == 0)
+			continue;
+		getBucketBounds(_positive.offset + i, lower, upper);
+		addToBins(std::max(lower, _min), std::min(upper, _max), _positive.counts[i], edges, bins);
+	}
+}
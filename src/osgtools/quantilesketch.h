@@ -0,0 +1,130 @@
+/*
+	quantilesketch.h
+	Mergeable streaming histogram of unbounded values
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <vector>
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Streaming sketch of a distribution (DDSketch). Values are counted in
+	 *	logarithmic buckets, so any quantile is estimated within a relative
+	 *	error, memory is bounded by the number of buckets rather than the
+	 *	number of values, and no range has to be chosen ahead of time.
+	 *
+	 *	Sketches with the same accuracy merge by adding bucket counts, so
+	 *	each producer thread can fill its own sketch without contention and
+	 *	the viewer merges them. Show a sketch with Histogram::setSketch,
+	 *	which rebins it into the current range.
+	 *
+	 *	Past the bucket limit, the buckets of the smallest magnitudes are
+	 *	merged, keeping the accuracy of the large values (the tail of a
+	 *	latency distribution).
+	 */
+	class OSGTOOLS QuantileSketch {
+	protected:
+		/*!
+		 *	Counts of consecutive bucket indices
+		 */
+		struct Store {
+			std::vector<double> counts;
+			int offset;					/*!< Index of counts[0] */
+
+			Store() : offset(0) {}
+
+			/*!
+			 *	Adds to a bucket, growing the store and merging its lowest
+			 *	buckets past maxBuckets
+			 */
+			void add( int index, double count, int maxBuckets );
+		};
+
+		double _relativeAccuracy;
+		double _gamma;					/*!< Ratio of the bounds of a bucket */
+		double _logGamma;
+		int _maxBuckets;				/*!< Most buckets of each sign */
+		Store _positive;
+		Store _negative;				/*!< Buckets of -value */
+		double _zeroCount;				/*!< Values too small for a bucket */
+		double _count;
+		double _min;
+		double _max;
+
+		// Constants
+		static const double MIN_VALUE;
+
+		int getIndex( double value ) const;
+
+		/*!
+		 *	Gets the value range [lower, upper] of a bucket
+		 */
+		void getBucketBounds( int index, double& lower, double& upper ) const;
+
+		/*!
+		 *	Spreads a count evenly over [lower, upper], or adds it to the bin
+		 *	of lower if the span is empty
+		 */
+		void addToBins( double lower, double upper, double count, const std::vector<float>& edges, std::vector<float>& bins ) const;
+
+	public:
+		/*!
+		 *	Creates an empty sketch
+		 *	\param	relativeAccuracy	The relative error of the quantiles
+		 *	\param	maxBuckets			The most buckets of each sign. The
+		 *								default covers 1e-9 to 1e9 at 1%.
+		 */
+		QuantileSketch( double relativeAccuracy = 0.01, int maxBuckets = 2048 );
+
+		/*!
+		 *	Counts a value
+		 *	\param	value	The value, of any magnitude
+		 *	\param	count	The weight of the value
+		 */
+		void add( double value, double count = 1.0 );
+
+		/*!
+		 *	Adds the counts of another sketch
+		 *	\return	True if the sketches have the same accuracy
+		 */
+		bool merge( const QuantileSketch& sketch );
+
+		/*!
+		 *	Removes all values
+		 */
+		void clear();
+
+		double getCount() const { return _count; }
+		double getMin() const { return _min; }
+		double getMax() const { return _max; }
+		double getRelativeAccuracy() const { return _relativeAccuracy; }
+
+		/*!
+		 *	Gets the number of buckets in use
+		 */
+		int getNumBuckets() const { return _positive.counts.size() + _negative.counts.size(); }
+
+		/*!
+		 *	Estimates a quantile
+		 *	\param	q	The quantile, from 0 to 1
+		 *	\return	The value, within the relative accuracy, or 0 if empty
+		 */
+		double getQuantile( double q ) const;
+
+		/*!
+		 *	Counts the values in bins, spreading each bucket evenly over its
+		 *	range. Values outside of the edges are not counted.
+		 *	\param	edges	Increasing edges, one more than the bins
+		 *	\param	bins	The count of each bin
+		 */
+		void getBins( const std::vector<float>& edges, std::vector<float>& bins ) const;
+	};
+}
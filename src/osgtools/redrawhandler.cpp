@@ -0,0 +1,63 @@
+/*
+	redrawhandler.cpp
+	On-demand rendering support for plots and widgets
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "redrawhandler.h"
+
+void osgtools::RedrawHandler::addPlot( Plot* pPlot )
+{
+	if (pPlot)
+		_plots.push_back(pPlot);
+}
+
+void osgtools::RedrawHandler::addWidget( Widget* pWidget )
+{
+	if (pWidget)
+		_widgets.push_back(pWidget);
+}
+
+bool osgtools::RedrawHandler::needsRedraw()
+{
+	for (int i=0; i < _plots.size(); i++) {
+		osg::ref_ptr<Plot> pPlot;
+		if (_plots[i].lock(pPlot) && pPlot->needsRedraw())
+			return true;
+	}
+	for (int i=0; i < _widgets.size(); i++) {
+		osg::ref_ptr<Widget> pWidget;
+		if (_widgets[i].lock(pWidget) && pWidget->needsRedraw())
+			return true;
+	}
+	return false;
+}
+
+bool osgtools::RedrawHandler::requestRedraw( osgGA::GUIActionAdapter& aa )
+{
+	if (!needsRedraw())
+		return false;
+	aa.requestRedraw();
+	return true;
+}
+
+bool osgtools::RedrawHandler::handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa )
+{
+	if (ea.getEventType() != osgGA::GUIEventAdapter::FRAME)
+		return false;
+
+	// This frame draws the current state
+	for (int i=0; i < _plots.size(); i++) {
+		osg::ref_ptr<Plot> pPlot;
+		if (_plots[i].lock(pPlot))
+			pPlot->clearRedraw();
+	}
+	for (int i=0; i < _widgets.size(); i++) {
+		osg::ref_ptr<Widget> pWidget;
+		if (_widgets[i].lock(pWidget))
+			pWidget->clearRedraw();
+	}
+	return false;
+}
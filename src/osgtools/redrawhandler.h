@@ -0,0 +1,73 @@
+/*
+	redrawhandler.h
+	On-demand rendering support for plots and widgets
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/observer_ptr>
+#include <osgGA/GUIEventHandler>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+#include "widget.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Tracks the redraw flags of plots and widgets for a viewer running
+	 *	on demand. Add the handler to the view, then drive the frame loop:
+	 *
+	 *		viewer.setRunFrameScheme(osgViewer::ViewerBase::ON_DEMAND);
+	 *		while (!viewer.done()) {
+	 *			pRedrawHandler->requestRedraw(viewer);
+	 *			if (viewer.checkNeedToDoFrame())
+	 *				viewer.frame();
+	 *			else
+	 *				OpenThreads::Thread::microSleep(10000);
+	 *		}
+	 */
+	class OSGTOOLS RedrawHandler : public osgGA::GUIEventHandler {
+	protected:
+		std::vector<osg::observer_ptr<Plot>> _plots;
+		std::vector<osg::observer_ptr<Widget>> _widgets;
+
+	public:
+		RedrawHandler() {}
+
+		/*!
+		 *	Adds a plot to watch
+		 */
+		void addPlot( Plot* pPlot );
+
+		/*!
+		 *	Adds a widget to watch
+		 */
+		void addWidget( Widget* pWidget );
+
+		/*!
+		 *	Gets whether any watched plot or widget changed
+		 *	\return	True if a frame needs to be drawn
+		 */
+		bool needsRedraw();
+
+		/*!
+		 *	Requests a redraw from the view if anything changed
+		 *	\param	aa	The view to request the redraw from
+		 *	\return	True if a redraw was requested
+		 */
+		bool requestRedraw( osgGA::GUIActionAdapter& aa );
+
+		/*!
+		 *	Clears the redraw flags as each frame starts
+		 */
+		virtual bool handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa );
+	};
+}
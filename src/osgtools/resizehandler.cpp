@@ -0,0 +1,67 @@
+/*
+	resizehandler.cpp
+	Propagates window resizes to plots and widgets
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "resizehandler.h"
+
+osgtools::ResizeHandler::ResizeHandler( int windowWidth, int windowHeight ) :
+	_windowWidth( windowWidth ),
+	_windowHeight( windowHeight )
+{
+
+}
+
+void osgtools::ResizeHandler::addPlot( Plot* pPlot )
+{
+	if (!pPlot || _windowWidth <= 0 || _windowHeight <= 0)
+		return;
+
+	PlotEntry entry;
+	entry.plot = pPlot;
+	entry.widthFraction = (float)pPlot->getWidth() / _windowWidth;
+	entry.heightFraction = (float)pPlot->getHeight() / _windowHeight;
+	_plots.push_back(entry);
+}
+
+void osgtools::ResizeHandler::addWidget( Widget* pWidget )
+{
+	if (pWidget)
+		_widgets.push_back(pWidget);
+}
+
+void osgtools::ResizeHandler::resize( int windowWidth, int windowHeight )
+{
+	if (windowWidth <= 0 || windowHeight <= 0)
+		return;
+	if (windowWidth == _windowWidth && windowHeight == _windowHeight)
+		return;
+	_windowWidth = windowWidth;
+	_windowHeight = windowHeight;
+
+	// Resize the plots
+	for (int i=0; i < _plots.size(); i++) {
+		osg::ref_ptr<Plot> pPlot;
+		if (_plots[i].plot.lock(pPlot))
+			pPlot->resize( _plots[i].widthFraction * _windowWidth + 0.5, _plots[i].heightFraction * _windowHeight + 0.5 );
+	}
+
+	// Resize the widgets
+	for (int i=0; i < _widgets.size(); i++) {
+		osg::ref_ptr<Widget> pWidget;
+		if (_widgets[i].lock(pWidget))
+			pWidget->resize( _windowWidth, _windowHeight );
+	}
+}
+
+bool osgtools::ResizeHandler::handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa )
+{
+	if (ea.getEventType() == osgGA::GUIEventAdapter::RESIZE)
+		resize( ea.getWindowWidth(), ea.getWindowHeight() );
+
+	// Let other handlers see the event
+	return false;
+}
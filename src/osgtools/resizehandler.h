@@ -0,0 +1,68 @@
+/*
+	resizehandler.h
+	Propagates window resizes to plots and widgets
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/observer_ptr>
+#include <osgGA/GUIEventHandler>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+#include "widget.h"
+
+namespace osgtools {
+
+	class OSGTOOLS ResizeHandler : public osgGA::GUIEventHandler {
+	protected:
+		int _windowWidth;			/*!< Width of the window in pixels */
+		int _windowHeight;			/*!< Height of the window in pixels */
+
+		/*!
+		 *	A plot sized as a fraction of the window
+		 */
+		struct PlotEntry {
+			osg::observer_ptr<Plot> plot;
+			float widthFraction;
+			float heightFraction;
+		};
+
+		std::vector<PlotEntry> _plots;
+		std::vector<osg::observer_ptr<Widget>> _widgets;
+
+	public:
+		ResizeHandler( int windowWidth, int windowHeight );
+
+		/*!
+		 *	Adds a plot. The plot keeps its current fraction of the window.
+		 *	\param	pPlot	The plot to resize with the window
+		 */
+		void addPlot( Plot* pPlot );
+
+		/*!
+		 *	Adds a widget
+		 *	\param	pWidget	The widget to resize with the window
+		 */
+		void addWidget( Widget* pWidget );
+
+		/*!
+		 *	Resizes the plots and widgets to a new window size
+		 *	\param	windowWidth		The width of the window in pixels
+		 *	\param	windowHeight	The height of the window in pixels
+		 */
+		void resize( int windowWidth, int windowHeight );
+
+		/*!
+		 *	Handles window resize events
+		 */
+		virtual bool handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa );
+	};
+}
@@ -0,0 +1,307 @@
+/*
+	shaders.cpp
+	Shared shader programs and core profile geometry helpers
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "shaders.h"
+
+#include <osg/Shader>
+#include <osg/Uniform>
+#include <osg/Version>
+
+// Constants
+const unsigned int osgtools::Shaders::PREVIOUS_VERTEX_LOCATION = 6;	// Unused by the OSG aliases
+
+// Vertex shader passing the vertex color
+static const char* COLOR_VERTEX_SHADER =
+	"#version 150\n"
+	"in vec4 osg_Vertex;\n"
+	"in vec4 osg_Color;\n"
+	"uniform mat4 osg_ModelViewProjectionMatrix;\n"
+	"out vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = osg_Color;\n"
+	"	gl_Position = osg_ModelViewProjectionMatrix * osg_Vertex;\n"
+	"}\n";
+
+// Fragment shader writing the vertex color
+static const char* COLOR_FRAGMENT_SHADER =
+	"#version 150\n"
+	"in vec4 vColor;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"	fragColor = vColor;\n"
+	"}\n";
+
+// Vertex shader passing the vertex color and texture coordinate
+static const char* TEXTURE_VERTEX_SHADER =
+	"#version 150\n"
+	"in vec4 osg_Vertex;\n"
+	"in vec4 osg_Color;\n"
+	"in vec4 osg_MultiTexCoord0;\n"
+	"uniform mat4 osg_ModelViewProjectionMatrix;\n"
+	"out vec4 vColor;\n"
+	"out vec2 vTexCoord;\n"
+	"void main() {\n"
+	"	vColor = osg_Color;\n"
+	"	vTexCoord = osg_MultiTexCoord0.xy;\n"
+	"	gl_Position = osg_ModelViewProjectionMatrix * osg_Vertex;\n"
+	"}\n";
+
+// Fragment shader modulating the texture by the vertex color
+static const char* TEXTURE_FRAGMENT_SHADER =
+	"#version 150\n"
+	"uniform sampler2D osgtools_Texture;\n"
+	"in vec4 vColor;\n"
+	"in vec2 vTexCoord;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"	fragColor = texture(osgtools_Texture, vTexCoord) * vColor;\n"
+	"}\n";
+
+// Fragment shader mapping the value texture to color through a colormap.
+// Cells holding NaN are left empty.
+static const char* COLORMAP_FRAGMENT_SHADER =
+	"#version 150\n"
+	"uniform sampler2D osgtools_Values;\n"
+	"uniform sampler1D osgtools_Colormap;\n"
+	"uniform vec2 osgtools_ValueRange;\n"
+	"in vec4 vColor;\n"
+	"in vec2 vTexCoord;\n"
+	"out vec4 fragColor;\n"
+	"void main() {\n"
+	"	float value = texture(osgtools_Values, vTexCoord).r;\n"
+	"	if (value != value) discard;\n"
+	"	float range = osgtools_ValueRange.y - osgtools_ValueRange.x;\n"
+	"	float t = clamp((value - osgtools_ValueRange.x) / (range > 0.0 ? range : 1.0), 0.0, 1.0);\n"
+	"	float size = float(textureSize(osgtools_Colormap, 0));\n"
+	"	fragColor = texture(osgtools_Colormap, (t * (size - 1.0) + 0.5) / size) * vColor;\n"
+	"}\n";
+
+// Vertex shader blending from the previous positions to the vertices
+static const char* TRANSITION_VERTEX_SHADER =
+	"#version 150\n"
+	"in vec4 osg_Vertex;\n"
+	"in vec4 osg_Color;\n"
+	"in vec4 osgtools_PreviousVertex;\n"
+	"uniform mat4 osg_ModelViewProjectionMatrix;\n"
+	"uniform float osgtools_Transition;\n"
+	"out vec4 vColor;\n"
+	"void main() {\n"
+	"	vColor = osg_Color;\n"
+	"	gl_Position = osg_ModelViewProjectionMatrix * mix(osgtools_PreviousVertex, osg_Vertex, osgtools_Transition);\n"
+	"}\n";
+
+// Vertex shader feeding the line geometry shader
+static const char* LINE_VERTEX_SHADER =
+	"#version 150\n"
+	"in vec4 osg_Vertex;\n"
+	"in vec4 osg_Color;\n"
+	"uniform mat4 osg_ModelViewProjectionMatrix;\n"
+	"out vec4 gColor;\n"
+	"void main() {\n"
+	"	gColor = osg_Color;\n"
+	"	gl_Position = osg_ModelViewProjectionMatrix * osg_Vertex;\n"
+	"}\n";
+
+// Geometry shader expanding each line into a quad osgtools_LineWidth pixels wide
+static const char* LINE_GEOMETRY_SHADER =
+	"#version 150\n"
+	"layout(lines) in;\n"
+	"layout(triangle_strip, max_vertices = 4) out;\n"
+	"uniform vec2 osgtools_Viewport;\n"
+	"uniform float osgtools_LineWidth;\n"
+	"in vec4 gColor[];\n"
+	"out vec4 vColor;\n"
+	"void main() {\n"
+	"	vec4 p0 = gl_in[0].gl_Position;\n"
+	"	vec4 p1 = gl_in[1].gl_Position;\n"
+	"	vec2 dir = (p1.xy/p1.w - p0.xy/p0.w) * osgtools_Viewport;\n"
+	"	if (dot(dir, dir) < 1e-8) return;\n"
+	"	dir = normalize(dir);\n"
+	"	vec2 offset = vec2(-dir.y, dir.x) * osgtools_LineWidth / osgtools_Viewport;\n"
+	"	vColor = gColor[0]; gl_Position = p0 + vec4(offset * p0.w, 0.0, 0.0); EmitVertex();\n"
+	"	vColor = gColor[0]; gl_Position = p0 - vec4(offset * p0.w, 0.0, 0.0); EmitVertex();\n"
+	"	vColor = gColor[1]; gl_Position = p1 + vec4(offset * p1.w, 0.0, 0.0); EmitVertex();\n"
+	"	vColor = gColor[1]; gl_Position = p1 - vec4(offset * p1.w, 0.0, 0.0); EmitVertex();\n"
+	"	EndPrimitive();\n"
+	"}\n";
+
+osg::Program* osgtools::Shaders::getColorProgram()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::Program> pProgram = createColorProgram();
+	return pProgram.get();
+}
+
+osg::Program* osgtools::Shaders::getTextureProgram()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::Program> pProgram = createTextureProgram();
+	return pProgram.get();
+}
+
+osg::Program* osgtools::Shaders::getColormapProgram()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::Program> pProgram = createColormapProgram();
+	return pProgram.get();
+}
+
+osg::Program* osgtools::Shaders::getLineProgram()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::Program> pProgram = createLineProgram();
+	return pProgram.get();
+}
+
+osg::Program* osgtools::Shaders::getTransitionProgram()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::Program> pProgram = createTransitionProgram();
+	return pProgram.get();
+}
+
+osg::Program* osgtools::Shaders::createColorProgram()
+{
+	osg::ref_ptr<osg::Program> pProgram = new osg::Program();
+	pProgram->setName("osgtools_Color");
+	pProgram->addShader(new osg::Shader(osg::Shader::VERTEX, COLOR_VERTEX_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, COLOR_FRAGMENT_SHADER));
+	return pProgram.release();
+}
+
+osg::Program* osgtools::Shaders::createTextureProgram()
+{
+	osg::ref_ptr<osg::Program> pProgram = new osg::Program();
+	pProgram->setName("osgtools_Texture");
+	pProgram->addShader(new osg::Shader(osg::Shader::VERTEX, TEXTURE_VERTEX_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, TEXTURE_FRAGMENT_SHADER));
+	return pProgram.release();
+}
+
+osg::Program* osgtools::Shaders::createColormapProgram()
+{
+	osg::ref_ptr<osg::Program> pProgram = new osg::Program();
+	pProgram->setName("osgtools_Colormap");
+	pProgram->addShader(new osg::Shader(osg::Shader::VERTEX, TEXTURE_VERTEX_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, COLORMAP_FRAGMENT_SHADER));
+	return pProgram.release();
+}
+
+osg::Program* osgtools::Shaders::createLineProgram()
+{
+	osg::ref_ptr<osg::Program> pProgram = new osg::Program();
+	pProgram->setName("osgtools_Line");
+	pProgram->addShader(new osg::Shader(osg::Shader::VERTEX, LINE_VERTEX_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::GEOMETRY, LINE_GEOMETRY_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, COLOR_FRAGMENT_SHADER));
+	return pProgram.release();
+}
+
+osg::Program* osgtools::Shaders::createTransitionProgram()
+{
+	osg::ref_ptr<osg::Program> pProgram = new osg::Program();
+	pProgram->setName("osgtools_Transition");
+	pProgram->addShader(new osg::Shader(osg::Shader::VERTEX, TRANSITION_VERTEX_SHADER));
+	pProgram->addShader(new osg::Shader(osg::Shader::FRAGMENT, COLOR_FRAGMENT_SHADER));
+	pProgram->addBindAttribLocation("osgtools_PreviousVertex", PREVIOUS_VERTEX_LOCATION);
+	return pProgram.release();
+}
+
+osg::DrawElementsUShort* osgtools::Shaders::getQuadIndices()
+{
+	// Created once, on whichever thread first asks
+	static osg::ref_ptr<osg::DrawElementsUShort> pIndices = createQuadIndices();
+	return pIndices.get();
+}
+
+osg::DrawElementsUShort* osgtools::Shaders::createQuadIndices()
+{
+	osg::ref_ptr<osg::DrawElementsUShort> pIndices = new osg::DrawElementsUShort(GL_TRIANGLES);
+	pIndices->push_back(0);
+	pIndices->push_back(1);
+	pIndices->push_back(2);
+	pIndices->push_back(0);
+	pIndices->push_back(2);
+	pIndices->push_back(3);
+	return pIndices.release();
+}
+
+void osgtools::Shaders::setupGeometry( osg::Geometry* pGeometry )
+{
+	if (!pGeometry)
+		return;
+	pGeometry->setUseDisplayList(false);
+	pGeometry->setUseVertexBufferObjects(true);
+#if OSG_VERSION_GREATER_OR_EQUAL(3,5,6)
+	pGeometry->setUseVertexArrayObject(true);
+#endif
+}
+
+void osgtools::Shaders::setLineWidth( osg::StateSet* pStateSet, float width )
+{
+	if (!pStateSet)
+		return;
+	pStateSet->setAttributeAndModes(getLineProgram(), osg::StateAttribute::ON);
+	pStateSet->addUniform(new osg::Uniform("osgtools_LineWidth", width));
+}
+
+void osgtools::Shaders::setTexture( osg::StateSet* pStateSet, osg::Texture* pTexture )
+{
+	if (!pStateSet)
+		return;
+	pStateSet->setTextureAttribute(0, pTexture, osg::StateAttribute::ON);
+	pStateSet->setAttributeAndModes(getTextureProgram(), osg::StateAttribute::ON);
+	pStateSet->addUniform(new osg::Uniform("osgtools_Texture", 0));
+}
+
+void osgtools::Shaders::setColormap( osg::StateSet* pStateSet, osg::Texture* pValues, osg::Texture* pColormap )
+{
+	if (!pStateSet)
+		return;
+	pStateSet->setTextureAttribute(0, pValues, osg::StateAttribute::ON);
+	pStateSet->setTextureAttribute(1, pColormap, osg::StateAttribute::ON);
+	pStateSet->setAttributeAndModes(getColormapProgram(), osg::StateAttribute::ON);
+	pStateSet->addUniform(new osg::Uniform("osgtools_Values", 0));
+	pStateSet->addUniform(new osg::Uniform("osgtools_Colormap", 1));
+}
+
+void osgtools::Shaders::setValueRange( osg::StateSet* pStateSet, float min, float max )
+{
+	if (!pStateSet)
+		return;
+	osg::Uniform* pUniform = pStateSet->getUniform("osgtools_ValueRange");
+	if (pUniform)
+		pUniform->set(osg::Vec2(min, max));
+	else {
+		pUniform = new osg::Uniform("osgtools_ValueRange", osg::Vec2(min, max));
+		pUniform->setDataVariance(osg::Object::DYNAMIC);
+		pStateSet->addUniform(pUniform);
+	}
+}
+
+void osgtools::Shaders::setViewport( osg::StateSet* pStateSet, int width, int height )
+{
+	if (!pStateSet)
+		return;
+	osg::Uniform* pUniform = pStateSet->getUniform("osgtools_Viewport");
+	if (pUniform)
+		pUniform->set(osg::Vec2(width, height));
+	else {
+		pUniform = new osg::Uniform("osgtools_Viewport", osg::Vec2(width, height));
+		pUniform->setDataVariance(osg::Object::DYNAMIC);
+		pStateSet->addUniform(pUniform);
+	}
+}
+
+void osgtools::Shaders::setupContext( osg::GraphicsContext* pContext )
+{
+	if (!pContext || !pContext->getState())
+		return;
+	pContext->getState()->setUseModelViewAndProjectionUniforms(true);
+	pContext->getState()->setUseVertexAttributeAliasing(true);
+}
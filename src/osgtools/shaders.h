@@ -0,0 +1,142 @@
+/*
+	shaders.h
+	Shared shader programs and core profile geometry helpers
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// OSG
+#include <osg/Geometry>
+#include <osg/GraphicsContext>
+#include <osg/PrimitiveSet>
+#include <osg/Program>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/ref_ptr>
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Programs shared by all plots and widgets. The shaders use the OSG
+	 *	attribute and matrix aliases (osg_Vertex, osg_Color,
+	 *	osg_ModelViewProjectionMatrix), so they run on GL3+ core contexts.
+	 *	On compatibility builds of OSG call setupContext() before realizing.
+	 */
+	class OSGTOOLS Shaders {
+	public:
+		/*!
+		 *	Gets the program drawing per vertex colors
+		 */
+		static osg::Program* getColorProgram();
+
+		/*!
+		 *	Gets the program drawing a texture on unit 0 modulated by color
+		 */
+		static osg::Program* getTextureProgram();
+
+		/*!
+		 *	Gets the program mapping a single channel float texture on unit 0
+		 *	to color through a 1D colormap texture on unit 1
+		 */
+		static osg::Program* getColormapProgram();
+
+		/*!
+		 *	Gets the program expanding GL_LINES into screen aligned quads.
+		 *	The width is set with setLineWidth() and the viewport with
+		 *	setViewport().
+		 */
+		static osg::Program* getLineProgram();
+
+		/*!
+		 *	Gets the program drawing per vertex colors at positions blended
+		 *	from the previous positions (vertex attribute
+		 *	PREVIOUS_VERTEX_LOCATION) to the vertices by the float uniform
+		 *	osgtools_Transition, so a geometry animates between two states
+		 *	with one uniform update per frame
+		 */
+		static osg::Program* getTransitionProgram();
+
+		/*!
+		 *	Vertex attribute location of the previous positions of the
+		 *	transition program
+		 */
+		static const unsigned int PREVIOUS_VERTEX_LOCATION;
+
+		/*!
+		 *	Gets the shared indices drawing a four vertex rectangle as two
+		 *	triangles (0, 1, 2) and (0, 2, 3)
+		 */
+		static osg::DrawElementsUShort* getQuadIndices();
+
+		/*!
+		 *	Sets up a geometry to use VBOs and VAOs only
+		 *	\param	pGeometry	The geometry to set up
+		 */
+		static void setupGeometry( osg::Geometry* pGeometry );
+
+		/*!
+		 *	Sets the line program and width on a state set
+		 *	\param	pStateSet	The state set of the lines
+		 *	\param	width		The line width in pixels
+		 */
+		static void setLineWidth( osg::StateSet* pStateSet, float width );
+
+		/*!
+		 *	Sets the texture program and a texture on unit 0 of a state set
+		 *	\param	pStateSet	The state set
+		 *	\param	pTexture	The texture
+		 */
+		static void setTexture( osg::StateSet* pStateSet, osg::Texture* pTexture );
+
+		/*!
+		 *	Sets the colormap program, a value texture on unit 0 and a
+		 *	colormap texture on unit 1 of a state set
+		 *	\param	pStateSet	The state set
+		 *	\param	pValues		The single channel float texture of values
+		 *	\param	pColormap	The 1D colormap texture
+		 */
+		static void setColormap( osg::StateSet* pStateSet, osg::Texture* pValues, osg::Texture* pColormap );
+
+		/*!
+		 *	Sets the values mapped to the ends of the colormap
+		 *	\param	pStateSet	The state set using the colormap program
+		 *	\param	min			The value mapped to the first color
+		 *	\param	max			The value mapped to the last color
+		 */
+		static void setValueRange( osg::StateSet* pStateSet, float min, float max );
+
+		/*!
+		 *	Sets the viewport size used by the line program
+		 *	\param	pStateSet	The state set of the camera
+		 *	\param	width		The viewport width in pixels
+		 *	\param	height		The viewport height in pixels
+		 */
+		static void setViewport( osg::StateSet* pStateSet, int width, int height );
+
+		/*!
+		 *	Enables the OSG uniform and attribute aliases on a context
+		 *	\param	pContext	The graphics context
+		 */
+		static void setupContext( osg::GraphicsContext* pContext );
+
+	protected:
+		/*!
+		 *	Builds the programs returned by the getters above
+		 */
+		static osg::Program* createColorProgram();
+		static osg::Program* createTextureProgram();
+		static osg::Program* createColormapProgram();
+		static osg::Program* createLineProgram();
+		static osg::Program* createTransitionProgram();
+
+		/*!
+		 *	Builds the indices returned by getQuadIndices()
+		 */
+		static osg::DrawElementsUShort* createQuadIndices();
+	};
+}
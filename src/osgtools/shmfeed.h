@@ -0,0 +1,274 @@
+/*
+	shmfeed.h
+	Shared memory feed of histogram frames between processes
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+/*!
+ *	Plain C header, so producers need neither OSG nor C++. Link with -lrt
+ *	on older glibc.
+ *
+ *	The feed is a POSIX shared memory object holding a header and three
+ *	slots of bins. One producer and one consumer each own a slot; the third
+ *	holds the newest published frame. Publishing and taking exchange the
+ *	owned slot with the newest one in a single atomic operation, so neither
+ *	side ever waits or copies, and the consumer always gets the newest
+ *	frame. Frames published while the consumer is busy are replaced, not
+ *	queued.
+ *
+ *	Producer:
+ *
+ *		osgtools_feed_header* pFeed = osgtools_feed_create("/daq", 1024);
+ *		while (running) {
+ *			float* bins = osgtools_feed_begin(pFeed);
+ *			... fill up to maxBins bins ...
+ *			osgtools_feed_publish(pFeed, numBins);
+ *		}
+ *		osgtools_feed_close(pFeed, 1024);
+ *		osgtools_feed_unlink("/daq");
+ *
+ *	The consumer is usually a HistogramFeed. The header is writable by both
+ *	processes, so the consumer keeps the maxBins returned by
+ *	osgtools_feed_open and passes it to the calls mapping slots, rather
+ *	than trusting the live header.
+ */
+
+#pragma once
+
+/* ftruncate and shm_open are POSIX, hidden by strict ISO C such as -std=c99.
+   Only takes effect when this header comes before any system header. */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OSGTOOLS_FEED_MAGIC		0x4f534746u		/*!< "OSGF" */
+#define OSGTOOLS_FEED_VERSION	1u
+#define OSGTOOLS_FEED_FRESH		4u				/*!< Set in middle when it holds a frame not yet taken */
+#define OSGTOOLS_FEED_ALIGN		64u				/*!< Slots start on their own cache line */
+
+typedef struct osgtools_feed_header {
+	uint32_t magic;			/*!< OSGTOOLS_FEED_MAGIC once the feed is ready */
+	uint32_t version;
+	uint32_t maxBins;		/*!< Bins each slot holds */
+	uint32_t middle;		/*!< Slot of the newest frame, or'ed with OSGTOOLS_FEED_FRESH */
+	uint32_t producerSlot;	/*!< Slot being filled, written by the producer only */
+	uint32_t consumerSlot;	/*!< Slot being shown, written by the consumer only */
+	uint64_t numFrames;		/*!< Frames published */
+} osgtools_feed_header;
+
+typedef struct osgtools_feed_slot {
+	uint64_t frame;			/*!< Number of the frame, from 1 */
+	uint32_t numBins;		/*!< Bins of the frame */
+	uint32_t reserved;
+	/* float bins[maxBins] follow */
+} osgtools_feed_slot;
+
+static inline size_t osgtools_feed_align( size_t size )
+{
+	return (size + OSGTOOLS_FEED_ALIGN - 1) / OSGTOOLS_FEED_ALIGN * OSGTOOLS_FEED_ALIGN;
+}
+
+static inline size_t osgtools_feed_slot_size( uint32_t maxBins )
+{
+	return osgtools_feed_align(sizeof(osgtools_feed_slot) + maxBins * sizeof(float));
+}
+
+/*!
+ *	Gets the size of the shared memory of a feed
+ */
+static inline size_t osgtools_feed_size( uint32_t maxBins )
+{
+	return osgtools_feed_align(sizeof(osgtools_feed_header)) + 3 * osgtools_feed_slot_size(maxBins);
+}
+
+static inline osgtools_feed_slot* osgtools_feed_get_slot( osgtools_feed_header* pFeed, uint32_t maxBins, uint32_t slot )
+{
+	return (osgtools_feed_slot*)((char*)pFeed + osgtools_feed_align(sizeof(osgtools_feed_header))
+		+ slot * osgtools_feed_slot_size(maxBins));
+}
+
+static inline float* osgtools_feed_get_bins( osgtools_feed_slot* pSlot )
+{
+	return (float*)(pSlot + 1);
+}
+
+/*!
+ *	Creates a feed, replacing any feed of the same name. Consumers attached
+ *	to the replaced feed keep it until they reopen.
+ *	\param	name	The shared memory name, starting with '/'
+ *	\param	maxBins	The most bins of a frame
+ *	\return	The feed, or NULL on failure
+ */
+static inline osgtools_feed_header* osgtools_feed_create( const char* name, uint32_t maxBins )
+{
+	size_t size = osgtools_feed_size(maxBins);
+	osgtools_feed_header* pFeed;
+	int fd;
+
+	shm_unlink(name);
+	fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+		return NULL;
+	if (ftruncate(fd, (off_t)size) != 0) {
+		close(fd);
+		shm_unlink(name);
+		return NULL;
+	}
+	pFeed = (osgtools_feed_header*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (pFeed == (osgtools_feed_header*)MAP_FAILED) {
+		shm_unlink(name);
+		return NULL;
+	}
+
+	/* The new object is zeroed; slot 0 is the producer's, 1 the newest, 2 the consumer's */
+	pFeed->version = OSGTOOLS_FEED_VERSION;
+	pFeed->maxBins = maxBins;
+	pFeed->middle = 1;
+	pFeed->producerSlot = 0;
+	pFeed->consumerSlot = 2;
+	__atomic_store_n(&pFeed->magic, OSGTOOLS_FEED_MAGIC, __ATOMIC_RELEASE);
+	return pFeed;
+}
+
+/*!
+ *	Opens an existing feed
+ *	\param	name		The shared memory name, starting with '/'
+ *	\param	pMaxBins	Set to the bins each slot holds, as mapped
+ *	\return	The feed, or NULL if it does not exist or is not a feed
+ */
+static inline osgtools_feed_header* osgtools_feed_open( const char* name, uint32_t* pMaxBins )
+{
+	osgtools_feed_header* pFeed;
+	struct stat info;
+	uint32_t maxBins;
+	size_t size;
+	int fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0)
+		return NULL;
+	if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(osgtools_feed_header)) {
+		close(fd);
+		return NULL;
+	}
+
+	/* Read the header first, rejecting other objects and feeds still being created */
+	pFeed = (osgtools_feed_header*)mmap(NULL, sizeof(osgtools_feed_header), PROT_READ, MAP_SHARED, fd, 0);
+	if (pFeed == (osgtools_feed_header*)MAP_FAILED) {
+		close(fd);
+		return NULL;
+	}
+	if (__atomic_load_n(&pFeed->magic, __ATOMIC_ACQUIRE) != OSGTOOLS_FEED_MAGIC
+		|| pFeed->version != OSGTOOLS_FEED_VERSION
+		|| (size_t)info.st_size < osgtools_feed_size(pFeed->maxBins)) {
+		munmap(pFeed, sizeof(osgtools_feed_header));
+		close(fd);
+		return NULL;
+	}
+	maxBins = pFeed->maxBins;
+	munmap(pFeed, sizeof(osgtools_feed_header));
+
+	/* Map the size of the feed, which osgtools_feed_close unmaps */
+	size = osgtools_feed_size(maxBins);
+	pFeed = (osgtools_feed_header*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (pFeed == (osgtools_feed_header*)MAP_FAILED)
+		return NULL;
+	*pMaxBins = maxBins;
+	return pFeed;
+}
+
+/*!
+ *	Unmaps a feed. The shared memory stays until it is unlinked.
+ *	\param	maxBins	The bins of the feed as created or opened
+ */
+static inline void osgtools_feed_close( osgtools_feed_header* pFeed, uint32_t maxBins )
+{
+	if (pFeed)
+		munmap(pFeed, osgtools_feed_size(maxBins));
+}
+
+static inline void osgtools_feed_unlink( const char* name )
+{
+	shm_unlink(name);
+}
+
+/*!
+ *	Gets the bins of the producer's slot to fill with the next frame
+ */
+static inline float* osgtools_feed_begin( osgtools_feed_header* pFeed )
+{
+	return osgtools_feed_get_bins(osgtools_feed_get_slot(pFeed, pFeed->maxBins, pFeed->producerSlot));
+}
+
+/*!
+ *	Publishes the filled slot as the newest frame
+ *	\param	numBins	The bins of the frame, at most maxBins
+ *	\return	The number of the frame
+ */
+static inline uint64_t osgtools_feed_publish( osgtools_feed_header* pFeed, uint32_t numBins )
+{
+	osgtools_feed_slot* pSlot = osgtools_feed_get_slot(pFeed, pFeed->maxBins, pFeed->producerSlot);
+	uint64_t frame = pFeed->numFrames + 1;
+	uint32_t previous;
+
+	pSlot->frame = frame;
+	pSlot->numBins = numBins < pFeed->maxBins ? numBins : pFeed->maxBins;
+	__atomic_store_n(&pFeed->numFrames, frame, __ATOMIC_RELAXED);
+
+	/* Release the bins with the slot and take back the previous newest slot */
+	previous = __atomic_exchange_n(&pFeed->middle, pFeed->producerSlot | OSGTOOLS_FEED_FRESH, __ATOMIC_ACQ_REL);
+	pFeed->producerSlot = previous & 3u;
+	return frame;
+}
+
+/*!
+ *	Copies and publishes a frame
+ *	\return	The number of the frame
+ */
+static inline uint64_t osgtools_feed_write( osgtools_feed_header* pFeed, const float* bins, uint32_t numBins )
+{
+	if (numBins > pFeed->maxBins)
+		numBins = pFeed->maxBins;
+	memcpy(osgtools_feed_begin(pFeed), bins, numBins * sizeof(float));
+	return osgtools_feed_publish(pFeed, numBins);
+}
+
+/*!
+ *	Takes the newest frame for the consumer. The slot stays the consumer's,
+ *	and its bins unchanged, until the next successful take. Its numBins
+ *	comes from the producer; clamp it to maxBins before reading the bins.
+ *	\param	maxBins	The bins returned by osgtools_feed_open
+ *	\return	The slot of the frame, or NULL if no frame was published since
+ *			the last take
+ */
+static inline osgtools_feed_slot* osgtools_feed_take( osgtools_feed_header* pFeed, uint32_t maxBins )
+{
+	uint32_t previous;
+	if (!(__atomic_load_n(&pFeed->middle, __ATOMIC_RELAXED) & OSGTOOLS_FEED_FRESH))
+		return NULL;
+
+	/* Hand back the shown slot and acquire the bins of the newest one */
+	previous = __atomic_exchange_n(&pFeed->middle, pFeed->consumerSlot, __ATOMIC_ACQ_REL);
+	if ((previous & 3u) > 2)
+		return NULL;
+	pFeed->consumerSlot = previous & 3u;
+	return osgtools_feed_get_slot(pFeed, maxBins, pFeed->consumerSlot);
+}
+
+#ifdef __cplusplus
+}
+#endif
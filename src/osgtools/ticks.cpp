@@ -0,0 +1,78 @@
+/*
+	ticks.cpp
+	Tick placement along plot axes
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "ticks.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	/*!
+	 *	Relative tolerance for values that land on a multiple of the step
+	 *	up to rounding
+	 */
+	const double TICK_EPSILON = 1e-9;
+
+	bool isFinite( double value )
+	{
+		return value - value == 0.0;
+	}
+}
+
+double osgtools::Ticks::getNiceStep( double range, int maxTicks )
+{
+	if (!(range > 0.0) || !isFinite(range) || maxTicks < 1)
+		return 0.0;
+
+	// Round the smallest allowed step up to 1, 2 or 5 times a power of ten
+	double minStep = range / maxTicks;
+	double power = pow(10.0, floor(log10(minStep)));
+	double mantissa = minStep / power;
+	if (mantissa <= 1.0 + TICK_EPSILON)
+		return power;
+	if (mantissa <= 2.0 + TICK_EPSILON)
+		return 2.0 * power;
+	if (mantissa <= 5.0 + TICK_EPSILON)
+		return 5.0 * power;
+	return 10.0 * power;
+}
+
+double osgtools::Ticks::getMinorStep( double majorStep )
+{
+	if (!(majorStep > 0.0) || !isFinite(majorStep))
+		return 0.0;
+
+	double power = pow(10.0, floor(log10(majorStep) + TICK_EPSILON));
+	double mantissa = majorStep / power;
+	if (fabs(mantissa - 5.0) < 1e-6)
+		return majorStep / 5.0;
+	return majorStep / 2.0;
+}
+
+bool osgtools::Ticks::getTicks( double min, double max, double step, int maxTicks, TickSpan& span )
+{
+	span = TickSpan();
+	if (!(step > 0.0) || !(max > min) || !isFinite(min) || !isFinite(max) || !isFinite(step) || maxTicks < 1)
+		return false;
+
+	// Coarsen steps too fine for the range
+	if ((max - min) / step > maxTicks)
+		step = getNiceStep(max - min, maxTicks);
+
+	// First multiple at or after min and last one before max
+	double first = ceil(min / step - TICK_EPSILON);
+	double last = ceil(max / step - TICK_EPSILON) - 1.0;
+	if (last < first)
+		return false;
+
+	span.first = first;
+	span.step = step;
+	span.count = (int)std::min(last - first + 1.0, (double)maxTicks);
+	return true;
+}
@@ -0,0 +1,64 @@
+/*
+	ticks.h
+	Tick placement along plot axes
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Ticks at whole multiples of a step, first * step to
+	 *	(first + count - 1) * step. Values are computed from the index, so
+	 *	they do not drift the way an accumulated sum does.
+	 */
+	struct TickSpan {
+		double first;		/*!< Index of the first tick */
+		double step;		/*!< Distance between ticks */
+		int count;			/*!< Number of ticks */
+
+		TickSpan() : first(0.0), step(0.0), count(0) {}
+
+		double getValue( int i ) const { return (first + i) * step; }
+	};
+
+	/*!
+	 *	Picks "nice" tick steps (1, 2 or 5 times a power of ten) and places
+	 *	a bounded number of ticks in a range
+	 */
+	class OSGTOOLS Ticks {
+	public:
+		/*!
+		 *	Gets the smallest nice step dividing a range into at most
+		 *	maxTicks steps
+		 *	\param	range		The length of the range
+		 *	\param	maxTicks	The largest number of steps
+		 *	\return	The step, or 0 if the range is empty or not finite
+		 */
+		static double getNiceStep( double range, int maxTicks );
+
+		/*!
+		 *	Gets the minor step of a nice major step, splitting 5 times a
+		 *	power of ten into five and the others into two
+		 */
+		static double getMinorStep( double majorStep );
+
+		/*!
+		 *	Places ticks at the multiples of a step in [min, max). If the
+		 *	step gives more than maxTicks ticks, the next nice step that
+		 *	does not is used instead.
+		 *	\param	min			The start of the range
+		 *	\param	max			The end of the range, excluded
+		 *	\param	step		The distance between ticks
+		 *	\param	maxTicks	The largest number of ticks
+		 *	\param	span		The ticks
+		 *	\return	True if any ticks were placed
+		 */
+		static bool getTicks( double min, double max, double step, int maxTicks, TickSpan& span );
+	};
+}
@@ -0,0 +1,96 @@
+/*
+	tooltipwidget.cpp
+	Text box following the cursor
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "tooltipwidget.h"
+#include "labelfont.h"
+#include "shaders.h"
+
+#include <algorithm>
+
+// Constants
+const osg::Vec4 osgtools::TooltipWidget::BOX_COLOR(1.0, 1.0, 0.9, 0.9);
+const osg::Vec4 osgtools::TooltipWidget::TEXT_COLOR(0.0, 0.0, 0.0, 1.0);
+const float osgtools::TooltipWidget::TEXT_SIZE = 14.0;
+const int osgtools::TooltipWidget::PADDING = 4;
+const int osgtools::TooltipWidget::CURSOR_OFFSET = 12;
+
+osgtools::TooltipWidget::TooltipWidget( int windowWidth, int windowHeight ) :
+	Widget(windowWidth, windowHeight, 0, 0, 0, 0)
+{
+	// Create the box
+	_pBox = new osg::Geometry();
+	_pBox->setDataVariance( osg::Object::DYNAMIC );
+	_pBox->setVertexArray( new osg::Vec3Array(4) );
+	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
+	pColors->push_back(BOX_COLOR);
+	_pBox->setColorArray( pColors.get() );
+	_pBox->setColorBinding( osg::Geometry::BIND_OVERALL );
+	_pBox->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( _pBox.get() );
+
+	// Create the text
+	_pText = new osgText::Text();
+	_pText->setDataVariance( osg::Object::DYNAMIC );
+	_pText->setCharacterSize(TEXT_SIZE);
+	LabelFont::setupText(_pText.get());
+	_pText->setCharacterSizeMode(osgText::Text::SCREEN_COORDS);
+	_pText->setAxisAlignment(osgText::Text::SCREEN);
+	_pText->setColor(TEXT_COLOR);
+	_pText->setDrawMode(osgText::Text::TEXT);
+	_pText->setPosition(osg::Vec3(PADDING, PADDING, 0));
+
+	_pGeode = new osg::Geode();
+	_pGeode->getOrCreateStateSet()->setMode(GL_BLEND, osg::StateAttribute::ON);
+	_pGeode->addDrawable( _pBox.get() );
+	_pGeode->addDrawable( _pText.get() );
+	addChild( _pGeode.get() );
+
+	hide();
+}
+
+void osgtools::TooltipWidget::setText( const std::string& text )
+{
+	if (text == _text)
+		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "setText");
+	_text = text;
+	_pText->setText(_text);
+	updateBox();
+	dirtyRedraw();
+}
+
+void osgtools::TooltipWidget::updateBox()
+{
+	// Size the widget to the text and its padding
+	const osg::BoundingBox& bound = _pText->getBoundingBox();
+	_width = (bound.valid() ? (int)(bound.xMax() - bound.xMin()) : 0) + 2 * PADDING;
+	_height = (bound.valid() ? (int)(bound.yMax() - bound.yMin()) : 0) + 2 * PADDING;
+
+	osg::Vec3Array* pVertices = static_cast<osg::Vec3Array*>( _pBox->getVertexArray() );
+	(*pVertices)[0].set(0, 0, -0.1);
+	(*pVertices)[1].set(_width, 0, -0.1);
+	(*pVertices)[2].set(_width, _height, -0.1);
+	(*pVertices)[3].set(0, _height, -0.1);
+	pVertices->dirty();
+	_pBox->dirtyBound();
+}
+
+void osgtools::TooltipWidget::moveTo( float x, float y )
+{
+	// Below right of the cursor, flipped to stay inside the window
+	float left = x + CURSOR_OFFSET;
+	float bottom = y - CURSOR_OFFSET - _height;
+	if (left + _width > _windowWidth)
+		left = x - CURSOR_OFFSET - _width;
+	if (bottom < 0)
+		bottom = y + CURSOR_OFFSET;
+
+	_x = std::max(left, 0.0f);
+	_y = std::max(bottom, 0.0f);
+	updateTransform();
+}
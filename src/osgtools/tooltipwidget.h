@@ -0,0 +1,63 @@
+/*
+	tooltipwidget.h
+	Text box following the cursor
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <string>
+
+// OSG
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osgText/Text>
+
+// Local
+#include "osgtools.h"
+#include "widget.h"
+
+namespace osgtools {
+
+	/*!
+	 *	A single text label on a box, shown next to the cursor. Used by
+	 *	PickHandler for hover readouts of plots.
+	 */
+	class OSGTOOLS TooltipWidget : public Widget {
+	protected:
+		osg::ref_ptr<osg::Geode> _pGeode;
+		osg::ref_ptr<osg::Geometry> _pBox;
+		osg::ref_ptr<osgText::Text> _pText;
+		std::string _text;
+
+		// Constants
+		static const osg::Vec4 BOX_COLOR;
+		static const osg::Vec4 TEXT_COLOR;
+		static const float TEXT_SIZE;
+		static const int PADDING;
+		static const int CURSOR_OFFSET;
+
+		/*!
+		 *	Fits the box to the text
+		 */
+		void updateBox();
+
+	public:
+		TooltipWidget( int windowWidth, int windowHeight );
+
+		/*!
+		 *	Sets the text, resizing the box
+		 */
+		void setText( const std::string& text );
+		const std::string& getText() { return _text; }
+
+		/*!
+		 *	Places the tooltip next to a cursor position, inside the window
+		 *	\param	x	The x pixel of the cursor in the window
+		 *	\param	y	The y pixel of the cursor in the window
+		 */
+		void moveTo( float x, float y );
+	};
+}
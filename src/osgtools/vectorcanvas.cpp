@@ -0,0 +1,303 @@
+/*
+	vectorcanvas.cpp
+	Vector output of plots as SVG and PDF
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "vectorcanvas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <locale>
+
+namespace {
+
+	/*!
+	 *	Formats numbers the same way in every locale
+	 */
+	void setupStream( std::ostream& out )
+	{
+		out.imbue(std::locale::classic());
+		out.setf(std::ios::fixed, std::ios::floatfield);
+		out.precision(3);
+	}
+
+	std::string svgColor( const osg::Vec4& color )
+	{
+		char s[32];
+		snprintf(s, sizeof(s), "#%02x%02x%02x",
+			(int)(std::min(std::max(color.r(), 0.0f), 1.0f) * 255 + 0.5),
+			(int)(std::min(std::max(color.g(), 0.0f), 1.0f) * 255 + 0.5),
+			(int)(std::min(std::max(color.b(), 0.0f), 1.0f) * 255 + 0.5));
+		return s;
+	}
+
+	std::string pdfColor( const osg::Vec4& color )
+	{
+		std::ostringstream s;
+		setupStream(s);
+		s << color.r() << " " << color.g() << " " << color.b();
+		return s.str();
+	}
+
+	std::string escapeXml( const std::string& text )
+	{
+		std::string escaped;
+		for (size_t i=0; i < text.size(); i++) {
+			switch (text[i]) {
+			case '&': escaped += "&amp;"; break;
+			case '<': escaped += "&lt;"; break;
+			case '>': escaped += "&gt;"; break;
+			case '"': escaped += "&quot;"; break;
+			default: escaped += text[i];
+			}
+		}
+		return escaped;
+	}
+
+	std::string escapePdf( const std::string& text )
+	{
+		std::string escaped;
+		for (size_t i=0; i < text.size(); i++) {
+			if (text[i] == '(' || text[i] == ')' || text[i] == '\\')
+				escaped += '\\';
+			escaped += text[i];
+		}
+		return escaped;
+	}
+}
+
+osgtools::SvgCanvas::SvgCanvas( std::ostream& out ) :
+	_out(out),
+	_height(0)
+{
+	setupStream(_defs);
+	setupStream(_body);
+}
+
+void osgtools::SvgCanvas::begin( int width, int height )
+{
+	_height = height;
+	_defs.str("");
+	_body.str("");
+	_gradients.clear();
+
+	_body << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"" << width
+		<< "\" height=\"" << height << "\" viewBox=\"0 0 " << width << " " << height << "\">\n";
+}
+
+int osgtools::SvgCanvas::getGradient( const std::string& color0, const std::string& color1 )
+{
+	std::pair<std::string,std::string> key(color0, color1);
+	std::map<std::pair<std::string,std::string>, int>::iterator it = _gradients.find(key);
+	if (it != _gradients.end())
+		return it->second;
+
+	int id = (int)_gradients.size();
+	_gradients[key] = id;
+	_defs << "<linearGradient id=\"g" << id << "\">"
+		<< "<stop offset=\"0\" stop-color=\"" << color0 << "\"/>"
+		<< "<stop offset=\"1\" stop-color=\"" << color1 << "\"/>"
+		<< "</linearGradient>\n";
+	return id;
+}
+
+void osgtools::SvgCanvas::rect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 )
+{
+	std::string c0 = svgColor(color0);
+	std::string c1 = svgColor(color1);
+
+	// The gradient runs left to right in the bounding box
+	if (x1 < x0) {
+		std::swap(x0, x1);
+		std::swap(c0, c1);
+	}
+	if (y1 < y0)
+		std::swap(y0, y1);
+
+	_body << "<rect x=\"" << x0 << "\" y=\"" << _height - y1 << "\" width=\"" << x1 - x0
+		<< "\" height=\"" << y1 - y0 << "\"";
+	if (c0 == c1)
+		_body << " fill=\"" << c0 << "\"";
+	else
+		_body << " fill=\"url(#g" << getGradient(c0, c1) << ")\"";
+	if (color0.a() < 1.0)
+		_body << " fill-opacity=\"" << color0.a() << "\"";
+	_body << "/>\n";
+}
+
+void osgtools::SvgCanvas::line( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color )
+{
+	_body << "<line x1=\"" << x0 << "\" y1=\"" << _height - y0 << "\" x2=\"" << x1 << "\" y2=\"" << _height - y1
+		<< "\" stroke=\"" << svgColor(color) << "\" stroke-width=\"" << width << "\"";
+	if (color.a() < 1.0)
+		_body << " stroke-opacity=\"" << color.a() << "\"";
+	_body << "/>\n";
+}
+
+void osgtools::SvgCanvas::polygon( const std::vector<osg::Vec2>& points, const osg::Vec4& color )
+{
+	if (points.size() < 3)
+		return;
+
+	_body << "<polygon points=\"";
+	for (size_t i=0; i < points.size(); i++)
+		_body << (i ? " " : "") << points[i].x() << "," << _height - points[i].y();
+	_body << "\" fill=\"" << svgColor(color) << "\"";
+	if (color.a() < 1.0)
+		_body << " fill-opacity=\"" << color.a() << "\"";
+	_body << "/>\n";
+}
+
+void osgtools::SvgCanvas::text( const std::string& text, float x, float y, float size, bool bRotated, const osg::Vec4& color )
+{
+	_body << "<text x=\"" << x << "\" y=\"" << _height - y << "\" font-family=\"Arial, Helvetica, sans-serif\" font-size=\""
+		<< size << "\" fill=\"" << svgColor(color) << "\"";
+	if (bRotated)
+		_body << " transform=\"rotate(-90 " << x << " " << _height - y << ")\"";
+	_body << ">" << escapeXml(text) << "</text>\n";
+}
+
+bool osgtools::SvgCanvas::end()
+{
+	_out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	std::string body = _body.str();
+	std::string::size_type open = body.find('\n') + 1;
+
+	// Definitions go right after the opening tag
+	_out.write(body.data(), open);
+	if (!_gradients.empty())
+		_out << "<defs>\n" << _defs.str() << "</defs>\n";
+	_out.write(body.data() + open, body.size() - open);
+	_out << "</svg>\n";
+	_out.flush();
+	return _out.good();
+}
+
+osgtools::PdfCanvas::PdfCanvas( std::ostream& out ) :
+	_out(out),
+	_width(0),
+	_height(0)
+{
+	setupStream(_content);
+}
+
+void osgtools::PdfCanvas::begin( int width, int height )
+{
+	_width = width;
+	_height = height;
+	_content.str("");
+	_shadings.clear();
+	_shadingIds.clear();
+}
+
+int osgtools::PdfCanvas::getShading( const std::string& color0, const std::string& color1 )
+{
+	std::pair<std::string,std::string> key(color0, color1);
+	std::map<std::pair<std::string,std::string>, int>::iterator it = _shadingIds.find(key);
+	if (it != _shadingIds.end())
+		return it->second;
+
+	// Axial shading across the unit square, mapped onto each rectangle
+	int id = (int)_shadings.size();
+	_shadingIds[key] = id;
+	_shadings.push_back("<< /ShadingType 2 /ColorSpace /DeviceRGB /Coords [0 0 1 0] "
+		"/Function << /FunctionType 2 /Domain [0 1] /C0 [" + color0 + "] /C1 [" + color1 + "] /N 1 >> >>");
+	return id;
+}
+
+void osgtools::PdfCanvas::rect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 )
+{
+	if (x0 == x1 || y0 == y1)
+		return;
+
+	std::string c0 = pdfColor(color0);
+	std::string c1 = pdfColor(color1);
+	if (c0 == c1) {
+		_content << c0 << " rg " << x0 << " " << y0 << " " << x1 - x0 << " " << y1 - y0 << " re f\n";
+	}
+	else {
+		_content << "q " << x1 - x0 << " 0 0 " << y1 - y0 << " " << x0 << " " << y0
+			<< " cm 0 0 1 1 re W n /Sh" << getShading(c0, c1) << " sh Q\n";
+	}
+}
+
+void osgtools::PdfCanvas::line( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color )
+{
+	_content << width << " w " << pdfColor(color) << " RG " << x0 << " " << y0 << " m "
+		<< x1 << " " << y1 << " l S\n";
+}
+
+void osgtools::PdfCanvas::polygon( const std::vector<osg::Vec2>& points, const osg::Vec4& color )
+{
+	if (points.size() < 3)
+		return;
+
+	_content << pdfColor(color) << " rg " << points[0].x() << " " << points[0].y() << " m";
+	for (size_t i=1; i < points.size(); i++)
+		_content << " " << points[i].x() << " " << points[i].y() << " l";
+	_content << " h f\n";
+}
+
+void osgtools::PdfCanvas::text( const std::string& text, float x, float y, float size, bool bRotated, const osg::Vec4& color )
+{
+	_content << "BT /F1 " << size << " Tf " << pdfColor(color) << " rg "
+		<< (bRotated ? "0 1 -1 0 " : "1 0 0 1 ") << x << " " << y << " Tm ("
+		<< escapePdf(text) << ") Tj ET\n";
+}
+
+bool osgtools::PdfCanvas::end()
+{
+	std::ostringstream doc;
+	setupStream(doc);
+	std::vector<std::streamoff> offsets;
+	std::string content = _content.str();
+
+	doc << "%PDF-1.4\n";
+
+	offsets.push_back(doc.tellp());
+	doc << "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+
+	offsets.push_back(doc.tellp());
+	doc << "2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n";
+
+	offsets.push_back(doc.tellp());
+	doc << "3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " << _width << " " << _height << "]"
+		<< " /Resources << /Font << /F1 4 0 R >>";
+	if (!_shadings.empty()) {
+		doc << " /Shading <<";
+		for (size_t i=0; i < _shadings.size(); i++)
+			doc << " /Sh" << i << " " << 6 + i << " 0 R";
+		doc << " >>";
+	}
+	doc << " >> /Contents 5 0 R >>\nendobj\n";
+
+	offsets.push_back(doc.tellp());
+	doc << "4 0 obj\n<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica /Encoding /WinAnsiEncoding >>\nendobj\n";
+
+	offsets.push_back(doc.tellp());
+	doc << "5 0 obj\n<< /Length " << content.size() << " >>\nstream\n" << content << "endstream\nendobj\n";
+
+	for (size_t i=0; i < _shadings.size(); i++) {
+		offsets.push_back(doc.tellp());
+		doc << 6 + i << " 0 obj\n" << _shadings[i] << "\nendobj\n";
+	}
+
+	// Cross reference table
+	std::streamoff xref = doc.tellp();
+	doc << "xref\n0 " << offsets.size() + 1 << "\n0000000000 65535 f \n";
+	for (size_t i=0; i < offsets.size(); i++) {
+		char entry[32];
+		snprintf(entry, sizeof(entry), "%010lld 00000 n \n", (long long)offsets[i]);
+		doc << entry;
+	}
+	doc << "trailer\n<< /Size " << offsets.size() + 1 << " /Root 1 0 R >>\nstartxref\n" << xref << "\n%%EOF\n";
+
+	std::string pdf = doc.str();
+	_out.write(pdf.data(), pdf.size());
+	_out.flush();
+	return _out.good();
+}
@@ -0,0 +1,130 @@
+/*
+	vectorcanvas.h
+	Vector output of plots as SVG and PDF
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// OSG
+#include <osg/Vec2>
+#include <osg/Vec4>
+
+// Local
+#include "osgtools.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Receives the primitives of a plot in plot pixels, with the origin at
+	 *	the bottom left as in the plot's projection. A canvas touches no GL
+	 *	state, so plots can be written without a context and on any thread
+	 *	(one canvas per thread).
+	 */
+	class OSGTOOLS VectorCanvas {
+	public:
+		virtual ~VectorCanvas() {}
+
+		/*!
+		 *	Starts a page
+		 *	\param	width	The width of the page in pixels
+		 *	\param	height	The height of the page in pixels
+		 */
+		virtual void begin( int width, int height ) = 0;
+
+		/*!
+		 *	Fills a rectangle, shaded from color0 at x0 to color1 at x1
+		 */
+		virtual void rect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 ) = 0;
+
+		/*!
+		 *	Strokes a line
+		 */
+		virtual void line( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color ) = 0;
+
+		/*!
+		 *	Fills a simple polygon
+		 *	\param	points	The corners, in order around the polygon
+		 */
+		virtual void polygon( const std::vector<osg::Vec2>& points, const osg::Vec4& color ) = 0;
+
+		/*!
+		 *	Draws text with its baseline starting at (x, y)
+		 *	\param	bRotated	True to run the text upwards
+		 */
+		virtual void text( const std::string& text, float x, float y, float size, bool bRotated, const osg::Vec4& color ) = 0;
+
+		/*!
+		 *	Finishes the page and writes it to the stream
+		 *	\return	True if the page was written
+		 */
+		virtual bool end() = 0;
+	};
+
+	/*!
+	 *	Writes a plot as an SVG document
+	 */
+	class OSGTOOLS SvgCanvas : public VectorCanvas {
+	protected:
+		std::ostream& _out;
+		int _height;
+
+		std::ostringstream _defs;					/*!<	Gradient definitions */
+		std::ostringstream _body;					/*!<	Drawing elements */
+		std::map<std::pair<std::string,std::string>, int> _gradients;	/*!<	Gradient id by color pair */
+
+		/*!
+		 *	Gets the id of the gradient between two colors, defining it once
+		 */
+		int getGradient( const std::string& color0, const std::string& color1 );
+
+	public:
+		SvgCanvas( std::ostream& out );
+
+		virtual void begin( int width, int height );
+		virtual void rect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 );
+		virtual void line( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color );
+		virtual void polygon( const std::vector<osg::Vec2>& points, const osg::Vec4& color );
+		virtual void text( const std::string& text, float x, float y, float size, bool bRotated, const osg::Vec4& color );
+		virtual bool end();
+	};
+
+	/*!
+	 *	Writes a plot as a single page PDF document. One pixel is one point.
+	 *	Text uses the standard Helvetica font, so nothing is embedded.
+	 */
+	class OSGTOOLS PdfCanvas : public VectorCanvas {
+	protected:
+		std::ostream& _out;
+		int _width;
+		int _height;
+
+		std::ostringstream _content;				/*!<	Page content stream */
+		std::vector<std::string> _shadings;			/*!<	Axial shading objects */
+		std::map<std::pair<std::string,std::string>, int> _shadingIds;	/*!<	Shading index by color pair */
+
+		/*!
+		 *	Gets the index of the shading between two colors, defining it once
+		 */
+		int getShading( const std::string& color0, const std::string& color1 );
+
+	public:
+		PdfCanvas( std::ostream& out );
+
+		virtual void begin( int width, int height );
+		virtual void rect( float x0, float y0, float x1, float y1, const osg::Vec4& color0, const osg::Vec4& color1 );
+		virtual void line( float x0, float y0, float x1, float y1, float width, const osg::Vec4& color );
+		virtual void polygon( const std::vector<osg::Vec2>& points, const osg::Vec4& color );
+		virtual void text( const std::string& text, float x, float y, float size, bool bRotated, const osg::Vec4& color );
+		virtual bool end();
+	};
+}
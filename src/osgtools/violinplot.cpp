@@ -0,0 +1,162 @@
+/*
+	violinplot.cpp
+	Violin plot of many distributions for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "violinplot.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// Constants
+const float osgtools::ViolinPlot::MEDIAN_WIDTH = 2.0;
+
+osgtools::ViolinPlot::ViolinPlot( int width, int height ) :
+	DistributionPlot( width, height )
+{
+}
+
+void osgtools::ViolinPlot::getValueRange( int i, float& min, float& max ) const
+{
+	min = _violins[i].min;
+	max = _violins[i].max;
+}
+
+bool osgtools::ViolinPlot::setViolins( const std::vector<ViolinSummary>& violins )
+{
+	// Handle bad input
+	if (violins.empty())
+		return false;
+	for (int i=0; i < violins.size(); i++) {
+		if (violins[i].density.size() < 2)
+			return false;
+	}
+
+	_violins = violins;
+	updateDistributions();
+	return true;
+}
+
+bool osgtools::ViolinPlot::setViolin( int i, const ViolinSummary& violin )
+{
+	if (i < 0 || i >= _violins.size() || violin.density.size() < 2)
+		return false;
+
+	_violins[i] = violin;
+	updateDistributions();
+	return true;
+}
+
+void osgtools::ViolinPlot::getSummary( const QuantileSketch& sketch, int numSamples, ViolinSummary& violin )
+{
+	numSamples = std::max(numSamples, 2);
+	violin.min = sketch.getMin();
+	violin.max = sketch.getMax();
+	violin.median = sketch.getQuantile(0.5);
+
+	// Count into bins centered on the samples
+	double step = (violin.max - violin.min) / (numSamples - 1);
+	if (step <= 0)
+		step = 1;
+	std::vector<float> edges(numSamples + 1);
+	for (int i=0; i <= numSamples; i++)
+		edges[i] = violin.min + (i - 0.5) * step;
+	sketch.getBins(edges, violin.density);
+	for (int i=0; i < numSamples; i++)
+		violin.density[i] /= step;
+}
+
+void osgtools::ViolinPlot::computeOutline( int i, const int* dim, osg::Vec2& median0, osg::Vec2& median1 ) const
+{
+	const ViolinSummary& violin = _violins[i];
+	int numSamples = violin.density.size();
+	float maxDensity = *std::max_element(violin.density.begin(), violin.density.end());
+	float scale = (maxDensity > 0 ? HALF_WIDTH / maxDensity : 0);
+
+	// Mirror the density around the center of the violin
+	_outline.resize(numSamples * 2);
+	float step = (violin.max - violin.min) / (numSamples - 1);
+	for (int j=0; j < numSamples; j++) {
+		float y = getClampedPixel(1, violin.min + j * step, dim);
+		float halfWidth = violin.density[j] * scale;
+		_outline[j*2 + 0].set(getClampedPixel(0, i - halfWidth, dim), y);
+		_outline[j*2 + 1].set(getClampedPixel(0, i + halfWidth, dim), y);
+	}
+
+	// The median spans the interpolated width
+	float t = (step > 0 ? (violin.median - violin.min) / step : 0);
+	int j = std::min(std::max((int)t, 0), numSamples - 2);
+	t = std::min(std::max(t - j, 0.0f), 1.0f);
+	float halfWidth = (violin.density[j] * (1 - t) + violin.density[j + 1] * t) * scale;
+	float y = getClampedPixel(1, violin.median, dim);
+	median0.set(getClampedPixel(0, i - halfWidth, dim), y);
+	median1.set(getClampedPixel(0, i + halfWidth, dim), y);
+}
+
+void osgtools::ViolinPlot::redraw()
+{
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "redraw");
+
+	if (!_pShapes.valid())
+		return;
+
+	// A quad between each pair of samples, shaded across like the bars
+	beginShapes();
+	for (int i=0; i < _violins.size(); i++) {
+		osg::Vec2 median0, median1;
+		computeOutline(i, _layoutDim, median0, median1);
+		for (int j=2; j < _outline.size(); j += 2)
+			addQuad(_outline[j - 2], _outline[j - 1], _outline[j + 1], _outline[j], _lightColor, _darkColor);
+		addLine(median0.x(), median0.y(), median1.x(), median1.y(), MEDIAN_WIDTH, _lineColor);
+	}
+	endShapes();
+}
+
+void osgtools::ViolinPlot::drawVectorData( VectorCanvas& canvas )
+{
+	std::vector<osg::Vec2> polygon;
+	for (int i=0; i < _violins.size(); i++) {
+		osg::Vec2 median0, median1;
+		computeOutline(i, _plotDim, median0, median1);
+
+		// Up the left edges and down the right ones
+		polygon.clear();
+		for (int j=0; j < _outline.size(); j += 2)
+			polygon.push_back(_outline[j]);
+		for (int j=(int)_outline.size() - 1; j > 0; j -= 2)
+			polygon.push_back(_outline[j]);
+		canvas.polygon(polygon, _lightColor);
+		canvas.line(median0.x(), median0.y(), median1.x(), median1.y(), MEDIAN_WIDTH, _lineColor);
+	}
+}
+
+bool osgtools::ViolinPlot::pick( float x, float y, PlotPick& pick )
+{
+	if (x < _plotDim[0] || x > _plotDim[0] + _plotDim[2] || y < _plotDim[1] || y > _plotDim[1] + _plotDim[3])
+		return false;
+	int i = getDistribution(getXPixelValue(x));
+	if (i < 0)
+		return false;
+
+	pick.series = 0;
+	pick.index = i;
+	pick.row = -1;
+	pick.x = i;
+	pick.y = getYPixelValue(y);
+	pick.value = _violins[i].median;
+	return true;
+}
+
+std::string osgtools::ViolinPlot::getPickText( const PlotPick& pick )
+{
+	if (pick.index < 0 || pick.index >= _violins.size())
+		return Plot::getPickText(pick);
+
+	const ViolinSummary& violin = _violins[pick.index];
+	char s[128];
+	snprintf(s, sizeof(s), "%d: median %g, range [%g, %g]", pick.index, violin.median, violin.min, violin.max);
+	return s;
+}
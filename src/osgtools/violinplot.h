@@ -0,0 +1,105 @@
+/*
+	violinplot.h
+	Violin plot of many distributions for OSG
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// STL
+#include <vector>
+
+// Local
+#include "osgtools.h"
+#include "distributionplot.h"
+#include "quantilesketch.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Density of a distribution, sampled at values evenly spaced from
+	 *	min to max (a kernel density estimate or smoothed histogram)
+	 */
+	struct ViolinSummary {
+		float min;					/*!< Value of the first sample */
+		float max;					/*!< Value of the last sample */
+		float median;
+		std::vector<float> density;	/*!< At least two samples */
+
+		ViolinSummary() : min(0), max(0), median(0) {}
+	};
+
+	/*!
+	 *	Draws the density of each distribution mirrored around its center.
+	 *	Each violin is a quad per pair of density samples plus a median line
+	 *	in the batched geometry, whatever the size of the data it
+	 *	summarises. Each violin is scaled to the full width at its densest.
+	 */
+	class OSGTOOLS ViolinPlot : public DistributionPlot {
+	protected:
+		std::vector<ViolinSummary> _violins;
+		mutable std::vector<osg::Vec2> _outline;	/*!< Pairs of left and right edges of the last violin computed */
+
+		// Constants
+		static const float MEDIAN_WIDTH;
+
+		virtual void getValueRange( int i, float& min, float& max ) const;
+
+		/*!
+		 *	Computes the outline of a violin into _outline, the left and
+		 *	right edge of each sample in turn
+		 *	\param	i		The violin
+		 *	\param	dim		The plot dimensions to map onto (_plotDim or _layoutDim)
+		 *	\param	median	The left and right ends of the median line
+		 */
+		void computeOutline( int i, const int* dim, osg::Vec2& median0, osg::Vec2& median1 ) const;
+
+		/*!
+		 *	Draws the violins of the vector output
+		 */
+		virtual void drawVectorData( VectorCanvas& canvas );
+
+	public:
+		ViolinPlot( int width, int height );
+
+		/*!
+		 *	Sets the summaries, replacing all violins
+		 *	\return	True if there are violins, each with two or more samples
+		 */
+		bool setViolins( const std::vector<ViolinSummary>& violins );
+
+		/*!
+		 *	Replaces the summary of a violin
+		 *	\return	True if the violin exists and has two or more samples
+		 */
+		bool setViolin( int i, const ViolinSummary& violin );
+
+		virtual int getNumDistributions() const { return _violins.size(); }
+
+		/*!
+		 *	Samples the density of a sketch from its smallest to its largest
+		 *	value
+		 *	\param	sketch		The sketch
+		 *	\param	numSamples	The number of samples, at least two
+		 *	\param	violin		The summary
+		 */
+		static void getSummary( const QuantileSketch& sketch, int numSamples, ViolinSummary& violin );
+
+		/*!
+		 *	Redraws the violins
+		 */
+		virtual void redraw();
+
+		/*!
+		 *	Finds the violin at a pixel. The index is the violin, the value its
+		 *	median.
+		 */
+		virtual bool pick( float x, float y, PlotPick& pick );
+
+		/*!
+		 *	Formats the summary of a pick
+		 */
+		virtual std::string getPickText( const PlotPick& pick );
+	};
+}
@@ -7,6 +7,7 @@
 */
 
 #include "widget.h"
+#include "shaders.h"
 
 osgtools::Widget::Widget( int windowWidth, int windowHeight, float x, float y, int width, int height ) :
 	_windowWidth( windowWidth ),
@@ -14,11 +15,14 @@ osgtools::Widget::Widget( int windowWidth, int windowHeight, float x, float y, i
 	_x(x),
 	_y(y),
 	_width(width),
-	_height(height)
+	_height(height),
+	_bNeedsRedraw(true),
+	_streamModifiedCount(0)
 {
 	// Create the HUD camera
 	_camera = createCamera();
 	osg::Switch::addChild( _camera.get() );
+	createTransform();
 
 	// Create the background
 	//_background = createGeode();
@@ -32,6 +36,7 @@ bool osgtools::Widget::setBackgroundImage( std::string& filePath )
 	if (!_camera.valid()) {
 		_camera = createCamera();
 		osg::Switch::addChild( _camera.get() );
+		createTransform();
 	}
 	
 	// Make sure the background exists
@@ -58,9 +63,12 @@ bool osgtools::Widget::setBackgroundImage( std::string& filePath )
 	osg::ref_ptr<osg::StateSet> stateset = _background->getOrCreateStateSet();
 	
 	// Assign the texture to unit 0
-	stateset->setTextureAttributeAndModes(0, _backgroundTexture.get(), osg::StateAttribute::ON);
+	Shaders::setTexture(stateset.get(), _backgroundTexture.get());
+#ifdef OSG_GL_FIXED_FUNCTION_AVAILABLE
 	stateset->setMode(GL_LIGHTING,osg::StateAttribute::OFF);
-	
+#endif
+
+	dirtyRedraw();
 	return true;
 }
 
@@ -79,26 +87,100 @@ osg::Camera* osgtools::Widget::createCamera()
 	// Clear the depth
 	pCamera->setClearMask(GL_DEPTH_BUFFER_BIT);
 
+	// Draw with the shared programs
+	pCamera->getOrCreateStateSet()->setAttributeAndModes(Shaders::getColorProgram(), osg::StateAttribute::ON);
+	Shaders::setViewport(pCamera->getOrCreateStateSet(), _windowWidth, _windowHeight);
+
 	return pCamera.release();
 }
 
+void osgtools::Widget::createTransform()
+{
+	_transform = new osg::MatrixTransform();
+	_transform->setDataVariance( osg::Object::DYNAMIC );
+	_camera->addChild( _transform.get() );
+	updateTransform();
+}
+
+void osgtools::Widget::updateTransform()
+{
+	if (_transform.valid())
+		_transform->setMatrix( osg::Matrix::translate(_x, _y, 0) );
+	dirtyRedraw();
+}
+
+void osgtools::Widget::updateGeode()
+{
+	if (!_background.valid() || _background->getNumDrawables() == 0)
+		return;
+
+	osg::Geometry* pRectangle = _background->getDrawable(0)->asGeometry();
+	osg::Vec3Array* pVecArray = (pRectangle ? dynamic_cast<osg::Vec3Array*>( pRectangle->getVertexArray() ) : 0);
+	if (!pVecArray || pVecArray->size() != 4)
+		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "updateGeode");
+
+	// Update the vertices in place
+	pVecArray->at(1).set( _width, 0, 0 );
+	pVecArray->at(2).set( _width, _height, 0 );
+	pVecArray->at(3).set( 0, _height, 0 );
+	pVecArray->dirty();
+	pRectangle->dirtyBound();
+	dirtyRedraw();
+}
+
+void osgtools::Widget::resize( int windowWidth, int windowHeight )
+{
+	if (windowWidth < 0 || windowHeight < 0)
+		return;
+	OSGTOOLS_BUILD_SCOPE(_buildStats, this, "resize");
+	_windowWidth = windowWidth;
+	_windowHeight = windowHeight;
+
+	if (!_camera.valid())
+		return;
+
+	// Update the projection
+	_camera->setProjectionMatrix(osg::Matrix::ortho2D(0,_windowWidth,0,_windowHeight));
+	_camera->setViewport(0,0,_windowWidth,_windowHeight);
+	Shaders::setViewport(_camera->getOrCreateStateSet(), _windowWidth, _windowHeight);
+	dirtyRedraw();
+}
+
+bool osgtools::Widget::needsRedraw()
+{
+	if (_bNeedsRedraw)
+		return true;
+
+	// New frames of the background stream
+	return (_backgroundImageStream.valid() && _backgroundImageStream->getModifiedCount() != _streamModifiedCount);
+}
+
+void osgtools::Widget::clearRedraw()
+{
+	_bNeedsRedraw = false;
+	if (_backgroundImageStream.valid())
+		_streamModifiedCount = _backgroundImageStream->getModifiedCount();
+}
+
 osg::Geode* osgtools::Widget::createGeode()
 {
 	osg::ref_ptr<osg::Geode> pGeode = new osg::Geode();
 	osg::ref_ptr<osg::Geometry> pRectangle = new osg::Geometry();
 
 	osg::ref_ptr<osg::Vec3Array> pVecArray = new osg::Vec3Array();
-	pVecArray->push_back( osg::Vec3(_x, _y, 0) );
-	pVecArray->push_back( osg::Vec3(_x + _width, _y, 0) );
-	pVecArray->push_back( osg::Vec3(_x + _width, _y + _width, 0) );
-	pVecArray->push_back( osg::Vec3(_x, _y + _width, 0) );
+	pVecArray->push_back( osg::Vec3(0, 0, 0) );
+	pVecArray->push_back( osg::Vec3(_width, 0, 0) );
+	pVecArray->push_back( osg::Vec3(_width, _height, 0) );
+	pVecArray->push_back( osg::Vec3(0, _height, 0) );
 	pRectangle->setVertexArray( pVecArray.get() );
 
 	osg::ref_ptr<osg::Vec4Array> colors = new osg::Vec4Array();
 	colors->push_back(osg::Vec4(1,1,1,0));
 	pRectangle->setColorArray( colors.get() );
 	pRectangle->setColorBinding( osg::Geometry::BIND_OVERALL );
-	pRectangle->addPrimitiveSet( new osg::DrawArrays(GL_QUADS, 0, 4) );
+	pRectangle->addPrimitiveSet( Shaders::getQuadIndices() );
+	Shaders::setupGeometry( pRectangle.get() );
 
 	osg::ref_ptr<osg::Vec2Array> pTextureCoords = new osg::Vec2Array(4);
 	pTextureCoords->at(0).set(0.0, 0.0);
@@ -114,7 +196,8 @@ osg::Geode* osgtools::Widget::createGeode()
 
 bool osgtools::Widget::addChild( osg::Node* pChild )
 {
-	if (!_camera.valid())
+	if (!_transform.valid())
 		return false;
-	return _camera->addChild( pChild );
+	dirtyRedraw();
+	return _transform->addChild( pChild );
 }
\ No newline at end of file
@@ -18,6 +18,10 @@
 #include <osg/ImageStream>
 #include <osg/Switch>
 #include <osg/Camera>
+#include <osg/MatrixTransform>
+
+// Local
+#include "buildstats.h"
 
 
 namespace osgtools {
@@ -30,14 +34,19 @@ namespace osgtools {
 		int _height;				/*!< Height of the widget in pixels */
 		float _x;					/*!< x-coordinate of the widget */
 		float _y;					/*!< y-coordinate of the widget */
+		bool _bNeedsRedraw;			/*!< Set when the widget changed since the last frame */
+		unsigned int _streamModifiedCount;	/*!< Background stream frame last drawn */
 		
 		osg::ref_ptr<osg::Camera> _camera;						/*!< HUD camera */
+		osg::ref_ptr<osg::MatrixTransform> _transform;			/*!< Positions the widget content at (x, y) */
 
 		osg::ref_ptr<osg::Geode> _background;					/*!< OSG geode node */
 		osg::ref_ptr<osg::Texture2D> _backgroundTexture;		/*!< OSG background texture */
 		osg::ref_ptr<osg::Image> _backgroundImage;				/*!< Background image */
 		osg::ref_ptr<osg::ImageStream> _backgroundImageStream;	/*!< Animated background */
 
+		BuildStats _buildStats;		/*!< Stats of the last rebuild (OSGTOOLS_ENABLE_STATS) */
+
 		/*!
 		 *	Creates a geode for the widget
 		 *	\return	A pointer to a geode
@@ -49,9 +58,24 @@ namespace osgtools {
 		 *	\return A pointer to a camera
 		 */
 		osg::Camera* createCamera();
+
+		/*!
+		 *	Creates the widget transform under the HUD camera
+		 */
+		void createTransform();
+
+		/*!
+		 *	Moves the widget content to the current position
+		 */
+		void updateTransform();
+
+		/*!
+		 *	Resizes the background geode in place
+		 */
+		void updateGeode();
 		
 	public:
-		Widget() {}
+		Widget() : _bNeedsRedraw(true), _streamModifiedCount(0) {}
 		Widget( int windowWidth, int windowHeight, float x, float y, int width, int height );
 		
 		
@@ -61,17 +85,51 @@ namespace osgtools {
 		int getX() { return _x; }
 		int getY() { return _y; }
 		
+		int getWindowWidth() { return _windowWidth; }
+		int getWindowHeight() { return _windowHeight; }
+		
 		// Setters
-		void setWidth(int width) { _width = width; }
-		void setHeight(int height) { _height = height; }
-		void setX( float x ) { _x = x; }
-		void setY( float y ) { _y = y; }
+		void setWidth(int width) { _width = width; updateGeode(); }
+		void setHeight(int height) { _height = height; updateGeode(); }
+		void setX( float x ) { _x = x; updateTransform(); }
+		void setY( float y ) { _y = y; updateTransform(); }
+
+		/*!
+		 *	Resizes the window the widget is drawn in. The HUD camera is
+		 *	updated; the widget keeps its pixel position and size.
+		 *	\param	windowWidth		The width of the window in pixels
+		 *	\param	windowHeight	The height of the window in pixels
+		 */
+		virtual void resize( int windowWidth, int windowHeight );
 		
 		bool setBackgroundImage( std::string& filePath );
-		void show() { setAllChildrenOn(); }
-		void hide() { setAllChildrenOff(); }
+		void show() { setAllChildrenOn(); dirtyRedraw(); }
+		void hide() { setAllChildrenOff(); dirtyRedraw(); }
 		
 		bool addChild( osg::Node* pChild );
+
+		/*!
+		 *	Marks the widget as changed so the next frame is drawn
+		 */
+		void dirtyRedraw() { _bNeedsRedraw = true; }
+
+		/*!
+		 *	Gets whether the widget changed since the last frame, including
+		 *	new frames of an animated background
+		 *	\return	True if the widget needs to be drawn
+		 */
+		bool needsRedraw();
+
+		/*!
+		 *	Clears the redraw flag once a frame has been drawn
+		 */
+		void clearRedraw();
+
+		/*!
+		 *	Gets the stats of the last rebuild. The counters stay zero unless
+		 *	the library is built with OSGTOOLS_ENABLE_STATS.
+		 */
+		const BuildStats& getBuildStats() { return _buildStats; }
 		
 		
 	};	
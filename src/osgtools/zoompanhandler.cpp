@@ -0,0 +1,277 @@
+/*
+	zoompanhandler.cpp
+	Mouse zoom and pan of a plot
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "zoompanhandler.h"
+#include "shaders.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Constants
+const float osgtools::ZoomPanHandler::ZOOM_FACTOR = 1.2;
+const double osgtools::ZoomPanHandler::WHEEL_END_DELAY = 0.25;
+const float osgtools::ZoomPanHandler::MIN_BOX_SIZE = 5.0;
+
+osgtools::ZoomPanHandler::ZoomPanHandler( Plot* pPlot, double layoutInterval ) :
+	_plot( pPlot ),
+	_bZoomed( false ),
+	_gesture( NONE ),
+	_startX( 0 ),
+	_startY( 0 ),
+	_layoutInterval( layoutInterval ),
+	_lastLayoutTime( 0 ),
+	_lastWheelTime( 0 )
+{
+	_homeRange[0] = _homeRange[1] = _homeRange[2] = _homeRange[3] = 0;
+	_startRange[0] = _startRange[1] = _startRange[2] = _startRange[3] = 0;
+
+	// Create the box zoom outline, shown while dragging
+	_pBoxGeo = new osg::Geometry();
+	_pBoxGeo->setDataVariance( osg::Object::DYNAMIC );
+	_pBoxGeo->setVertexArray( new osg::Vec3Array(4) );
+	osg::ref_ptr<osg::Vec4Array> pColors = new osg::Vec4Array();
+	pColors->push_back(osg::Vec4(0.0, 0.0, 0.0, 1.0));
+	_pBoxGeo->setColorArray( pColors.get() );
+	_pBoxGeo->setColorBinding( osg::Geometry::BIND_OVERALL );
+	_pBoxGeo->addPrimitiveSet( new osg::DrawArrays(GL_LINE_LOOP, 0, 4) );
+	Shaders::setupGeometry( _pBoxGeo.get() );
+
+	_pBoxGeode = new osg::Geode();
+	_pBoxGeode->addDrawable( _pBoxGeo.get() );
+	_pBoxGeode->setNodeMask( 0 );
+	if (pPlot)
+		pPlot->addChild( _pBoxGeode.get() );
+}
+
+void osgtools::ZoomPanHandler::setHomeRange( float xmin, float ymin, float xmax, float ymax )
+{
+	_homeRange[0] = xmin;
+	_homeRange[1] = ymin;
+	_homeRange[2] = xmax;
+	_homeRange[3] = ymax;
+	_bZoomed = true;
+}
+
+void osgtools::ZoomPanHandler::getPixel( const osgGA::GUIEventAdapter& ea, float& x, float& y ) const
+{
+	x = ea.getX() - ea.getXmin();
+	if (ea.getMouseYOrientation() == osgGA::GUIEventAdapter::Y_INCREASING_DOWNWARDS)
+		y = ea.getYmax() - ea.getY();
+	else
+		y = ea.getY() - ea.getYmin();
+}
+
+bool osgtools::ZoomPanHandler::isInPlotArea( Plot* pPlot, float x, float y ) const
+{
+	int startX, startY, width, height;
+	pPlot->getPlotDimensions(startX, startY, width, height);
+	return (x >= startX && x <= startX + width && y >= startY && y <= startY + height);
+}
+
+void osgtools::ZoomPanHandler::saveHomeRange( Plot* pPlot )
+{
+	if (_bZoomed)
+		return;
+	pPlot->getRange(_homeRange[0], _homeRange[1], _homeRange[2], _homeRange[3]);
+	_bZoomed = true;
+}
+
+void osgtools::ZoomPanHandler::zoom( Plot* pPlot, float x, float y, float factor )
+{
+	float range[4];
+	pPlot->getRange(range[0], range[1], range[2], range[3]);
+	float center[2] = { pPlot->getXPixelValue(x), pPlot->getYPixelValue(y) };
+
+	// Scale the range about the cursor
+	for (int axis=0; axis < 2; axis++) {
+		AxisScale* pScale = pPlot->getAxisScale(axis);
+		double c = pScale->forward(center[axis]);
+		double lo = c + (pScale->forward(range[axis]) - c) / factor;
+		double hi = c + (pScale->forward(range[axis + 2]) - c) / factor;
+		range[axis] = pScale->inverse(lo);
+		range[axis + 2] = pScale->inverse(hi);
+	}
+
+	// Stop before the range collapses to the float resolution
+	if (!(range[2] > range[0]) || !(range[3] > range[1]))
+		return;
+	pPlot->setViewRange(range[0], range[1], range[2], range[3]);
+}
+
+void osgtools::ZoomPanHandler::pan( Plot* pPlot, float dx, float dy )
+{
+	int startX, startY, width, height;
+	pPlot->getPlotDimensions(startX, startY, width, height);
+	if (width <= 0 || height <= 0)
+		return;
+
+	// Shift the start range in the scale space of the axes
+	float range[4];
+	float delta[2] = { dx / width, dy / height };
+	for (int axis=0; axis < 2; axis++) {
+		AxisScale* pScale = pPlot->getAxisScale(axis);
+		double lo = pScale->forward(_startRange[axis]);
+		double hi = pScale->forward(_startRange[axis + 2]);
+		double shift = (hi - lo) * delta[axis];
+		range[axis] = pScale->inverse(lo - shift);
+		range[axis + 2] = pScale->inverse(hi - shift);
+	}
+	pPlot->setViewRange(range[0], range[1], range[2], range[3]);
+}
+
+void osgtools::ZoomPanHandler::showBox( Plot* pPlot, float x0, float y0, float x1, float y1 )
+{
+	osg::Vec3Array* pVertices = static_cast<osg::Vec3Array*>( _pBoxGeo->getVertexArray() );
+	(*pVertices)[0].set(x0, y0, 0);
+	(*pVertices)[1].set(x1, y0, 0);
+	(*pVertices)[2].set(x1, y1, 0);
+	(*pVertices)[3].set(x0, y1, 0);
+	pVertices->dirty();
+	_pBoxGeo->dirtyBound();
+	_pBoxGeode->setNodeMask( ~0u );
+	pPlot->dirtyRedraw();
+}
+
+void osgtools::ZoomPanHandler::hideBox( Plot* pPlot )
+{
+	_pBoxGeode->setNodeMask( 0 );
+	pPlot->dirtyRedraw();
+}
+
+void osgtools::ZoomPanHandler::endGesture( Plot* pPlot )
+{
+	_gesture = NONE;
+
+	// Rebuild everything once at the final range
+	float range[4];
+	pPlot->getRange(range[0], range[1], range[2], range[3]);
+	pPlot->setRange(range[0], range[1], range[2], range[3]);
+}
+
+void osgtools::ZoomPanHandler::reset( Plot* pPlot )
+{
+	if (!_bZoomed)
+		return;
+	_gesture = NONE;
+	_bZoomed = false;
+	hideBox(pPlot);
+	pPlot->setRange(_homeRange[0], _homeRange[1], _homeRange[2], _homeRange[3]);
+}
+
+bool osgtools::ZoomPanHandler::handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa )
+{
+	osg::ref_ptr<Plot> pPlot;
+	if (!_plot.lock(pPlot))
+		return false;
+
+	float x, y;
+	switch (ea.getEventType()) {
+	case osgGA::GUIEventAdapter::FRAME:
+		// Finish a wheel zoom once the wheel stops
+		if (_gesture == WHEEL && ea.getTime() - _lastWheelTime > WHEEL_END_DELAY) {
+			endGesture(pPlot.get());
+			return false;
+		}
+
+		// Lay out the grid and labels at a throttled rate
+		if (pPlot->isViewLayoutDirty() && ea.getTime() - _lastLayoutTime >= _layoutInterval) {
+			pPlot->updateViewLayout();
+			_lastLayoutTime = ea.getTime();
+		}
+		return false;
+
+	case osgGA::GUIEventAdapter::SCROLL:
+		getPixel(ea, x, y);
+		if (!isInPlotArea(pPlot.get(), x, y))
+			return false;
+		if (ea.getScrollingMotion() != osgGA::GUIEventAdapter::SCROLL_UP &&
+			ea.getScrollingMotion() != osgGA::GUIEventAdapter::SCROLL_DOWN)
+			return false;
+		saveHomeRange(pPlot.get());
+		zoom(pPlot.get(), x, y, (ea.getScrollingMotion() == osgGA::GUIEventAdapter::SCROLL_UP ? ZOOM_FACTOR : 1.0 / ZOOM_FACTOR));
+		_gesture = WHEEL;
+		_lastWheelTime = ea.getTime();
+		return true;
+
+	case osgGA::GUIEventAdapter::DOUBLECLICK:
+		getPixel(ea, x, y);
+		if (!isInPlotArea(pPlot.get(), x, y))
+			return false;
+		reset(pPlot.get());
+		return true;
+
+	case osgGA::GUIEventAdapter::PUSH:
+		getPixel(ea, x, y);
+		if (!isInPlotArea(pPlot.get(), x, y))
+			return false;
+		if (_gesture == WHEEL)
+			endGesture(pPlot.get());
+		if (ea.getButton() == osgGA::GUIEventAdapter::LEFT_MOUSE_BUTTON)
+			_gesture = PAN;
+		else if (ea.getButton() == osgGA::GUIEventAdapter::RIGHT_MOUSE_BUTTON)
+			_gesture = BOX;
+		else
+			return false;
+		_startX = x;
+		_startY = y;
+		pPlot->getRange(_startRange[0], _startRange[1], _startRange[2], _startRange[3]);
+		return true;
+
+	case osgGA::GUIEventAdapter::DRAG:
+		if (_gesture != PAN && _gesture != BOX)
+			return false;
+		getPixel(ea, x, y);
+		if (_gesture == PAN) {
+			saveHomeRange(pPlot.get());
+			pan(pPlot.get(), x - _startX, y - _startY);
+		}
+		else {
+			showBox(pPlot.get(), _startX, _startY, x, y);
+		}
+		return true;
+
+	case osgGA::GUIEventAdapter::RELEASE:
+		if (_gesture == PAN) {
+			// A click without a drag keeps the data as built
+			getPixel(ea, x, y);
+			if (x == _startX && y == _startY)
+				_gesture = NONE;
+			else
+				endGesture(pPlot.get());
+			return true;
+		}
+		if (_gesture == BOX) {
+			hideBox(pPlot.get());
+			_gesture = NONE;
+			getPixel(ea, x, y);
+			if (fabs(x - _startX) < MIN_BOX_SIZE || fabs(y - _startY) < MIN_BOX_SIZE)
+				return true;
+
+			// Zoom to the box, rebuilding once
+			saveHomeRange(pPlot.get());
+			float x0 = pPlot->getXPixelValue(std::min(x, _startX));
+			float x1 = pPlot->getXPixelValue(std::max(x, _startX));
+			float y0 = pPlot->getYPixelValue(std::min(y, _startY));
+			float y1 = pPlot->getYPixelValue(std::max(y, _startY));
+			if (x1 > x0 && y1 > y0)
+				pPlot->setRange(x0, y0, x1, y1);
+			return true;
+		}
+		return false;
+
+	case osgGA::GUIEventAdapter::KEYDOWN:
+		if (ea.getKey() == 'r') {
+			reset(pPlot.get());
+			return true;
+		}
+		return false;
+
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,120 @@
+/*
+	zoompanhandler.h
+	Mouse zoom and pan of a plot
+
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+#pragma once
+
+// OSG
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/observer_ptr>
+#include <osgGA/GUIEventHandler>
+
+// Local
+#include "osgtools.h"
+#include "plot.h"
+
+namespace osgtools {
+
+	/*!
+	 *	Zooms and pans a plot with the mouse:
+	 *		- wheel zooms about the cursor
+	 *		- left drag pans
+	 *		- right drag zooms to the dragged box
+	 *		- 'r' or a double click resets to the range before zooming
+	 *
+	 *	During a gesture the plot is moved with setViewRange, so the data
+	 *	geometry is only transformed; the grid and labels are laid out again
+	 *	at most once per layout interval. The data is rebuilt once, at the
+	 *	final range, when the gesture ends.
+	 *
+	 *	The plot must be at the origin of the window.
+	 */
+	class OSGTOOLS ZoomPanHandler : public osgGA::GUIEventHandler {
+	protected:
+		osg::observer_ptr<Plot> _plot;
+
+		float _homeRange[4];			/*!< Range before the first zoom or pan */
+		bool _bZoomed;					/*!< Set when the range differs from _homeRange */
+
+		enum Gesture { NONE, PAN, BOX, WHEEL };
+		Gesture _gesture;
+		float _startX, _startY;			/*!< Pixel where the drag started */
+		float _startRange[4];			/*!< Range when the drag started */
+
+		double _layoutInterval;			/*!< Seconds between layouts of the grid and labels */
+		double _lastLayoutTime;
+		double _lastWheelTime;
+
+		osg::ref_ptr<osg::Geode> _pBoxGeode;	/*!< Outline of the box zoom */
+		osg::ref_ptr<osg::Geometry> _pBoxGeo;
+
+		// Constants
+		static const float ZOOM_FACTOR;
+		static const double WHEEL_END_DELAY;
+		static const float MIN_BOX_SIZE;
+
+		/*!
+		 *	Gets the mouse position in plot pixels
+		 */
+		void getPixel( const osgGA::GUIEventAdapter& ea, float& x, float& y ) const;
+
+		/*!
+		 *	Gets whether a pixel is inside the plot area
+		 */
+		bool isInPlotArea( Plot* pPlot, float x, float y ) const;
+
+		/*!
+		 *	Remembers the range to reset to, before the first change
+		 */
+		void saveHomeRange( Plot* pPlot );
+
+		/*!
+		 *	Zooms by a factor about a pixel, in the scale space of the axes
+		 */
+		void zoom( Plot* pPlot, float x, float y, float factor );
+
+		/*!
+		 *	Pans the start range by a pixel offset
+		 */
+		void pan( Plot* pPlot, float dx, float dy );
+
+		/*!
+		 *	Shows the box zoom outline between two pixels
+		 */
+		void showBox( Plot* pPlot, float x0, float y0, float x1, float y1 );
+		void hideBox( Plot* pPlot );
+
+		/*!
+		 *	Ends the gesture, rebuilding the plot at the final range
+		 */
+		void endGesture( Plot* pPlot );
+
+		/*!
+		 *	Resets the plot to the range before zooming
+		 */
+		void reset( Plot* pPlot );
+
+	public:
+		/*!
+		 *	Creates the handler
+		 *	\param	pPlot			The plot to zoom and pan
+		 *	\param	layoutInterval	Seconds between layouts of the grid and
+		 *							labels during a gesture
+		 */
+		ZoomPanHandler( Plot* pPlot, double layoutInterval = 0.05 );
+
+		/*!
+		 *	Sets the range to reset to
+		 */
+		void setHomeRange( float xmin, float ymin, float xmax, float ymax );
+
+		/*!
+		 *	Handles mouse, key and frame events
+		 */
+		virtual bool handle( const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa );
+	};
+}
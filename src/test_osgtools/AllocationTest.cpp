@@ -0,0 +1,150 @@
+/*
+	AllocationTest.cpp
+	Counts heap allocations of steady state plot updates
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "AllocationTest.h"
+
+TEST_F(AllocationTest, SteadyStateSetHistogram) {
+	// Warm up the pools
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->setHistogram(_bins);
+
+	uint64_t start = getAllocationCount();
+	_pHistogram->setHistogram(_bins);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "setHistogram allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateRedraw) {
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->redraw();
+
+	uint64_t start = getAllocationCount();
+	_pHistogram->redraw();
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "redraw allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateSetRange) {
+	_pHistogram->setHistogram(_bins);
+
+	// Alternate between two ranges with the same number of ticks
+	_pHistogram->setRange(-1, 0, 64, 10);
+	_pHistogram->setRange(-1, 0, 64, 9);
+
+	uint64_t start = getAllocationCount();
+	_pHistogram->setRange(-1, 0, 64, 10);
+	_pHistogram->setRange(-1, 0, 64, 9);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "setRange allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateSeries) {
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->addSeries(_bins, osg::Vec4(0.0, 0.0, 1.0, 1.0));
+	_pHistogram->setSeriesMode(osgtools::Histogram::STACKED);
+	_pHistogram->setSeries(1, _bins);
+
+	uint64_t start = getAllocationCount();
+	_pHistogram->setSeries(1, _bins);
+	_pHistogram->redraw();
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "Updating a series allocated in steady state";
+	EXPECT_EQ(_pHistogram->getNumSeries(), 2);
+}
+
+TEST_F(AllocationTest, SteadyStateSetHistogramInPlace) {
+	// Counts of a different type, read without copying
+	std::vector<int> counts(_bins.begin(), _bins.end());
+	_pHistogram->setHistogram(&counts[0], counts.size(), false);
+	_pHistogram->setHistogram(&counts[0], counts.size(), false);
+
+	uint64_t start = getAllocationCount();
+	counts[0]++;
+	_pHistogram->setHistogram(&counts[0], counts.size(), false);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "setHistogram in place allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateDensityOverlay) {
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->setDensityOverlay(0, 2.5);
+	_pHistogram->setRange(-1, 0, 64, 10);
+	_pHistogram->setRange(-1, 0, 64, 9);
+
+	// Panning maps the smoothed bins again, new bins smooth again
+	uint64_t start = getAllocationCount();
+	_pHistogram->setRange(-1, 0, 64, 10);
+	_pHistogram->setRange(-1, 0, 64, 9);
+	_pHistogram->setSeries(0, _bins);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "The density overlay allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateTransitions) {
+	_pHistogram->setTransitionDuration(0.5);
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->setHistogram(_bins);
+
+	// A change uploads the bars as shown and the new bars once
+	uint64_t start = getAllocationCount();
+	_pHistogram->setHistogram(_bins);
+	_pHistogram->setRange(-1, 0, 64, 10);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "Starting a transition allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateDistributions) {
+	// Hundreds of summaries in one plot each
+	std::vector<osgtools::BoxSummary> boxes;
+	std::vector<osgtools::ViolinSummary> violins(300);
+	for (int i=0; i < 300; i++) {
+		boxes.push_back(osgtools::BoxSummary(0, i % 7 + 1, i % 7 + 2, i % 7 + 3, 12));
+		violins[i].max = 10;
+		violins[i].median = 5;
+		for (int j=0; j < 32; j++)
+			violins[i].density.push_back((float)(j * (31 - j)));
+	}
+	osg::ref_ptr<osgtools::BoxPlot> pBoxes = new osgtools::BoxPlot(800, 600);
+	osg::ref_ptr<osgtools::ViolinPlot> pViolins = new osgtools::ViolinPlot(800, 600);
+	pBoxes->setBoxes(boxes);
+	pViolins->setViolins(violins);
+
+	uint64_t start = getAllocationCount();
+	pBoxes->redraw();
+	pViolins->redraw();
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "Redrawing distributions allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateDashboardChrome) {
+	osg::ref_ptr<osgtools::Dashboard> pDashboard = new osgtools::Dashboard(1600, 1200, 4);
+	for (int i=0; i < 16; i++) {
+		osg::ref_ptr<osgtools::Histogram> pHistogram = new osgtools::Histogram(400, 300);
+		pHistogram->setHistogram(_bins);
+		pDashboard->addPlot(pHistogram.get());
+	}
+	pDashboard->updateChrome();
+	pDashboard->getPlot(0)->setRange(-1, 0, 64, 9);
+	pDashboard->updateChrome();
+
+	// The chrome of all tiles is refilled in place when one tile changes
+	uint64_t start = getAllocationCount();
+	pDashboard->getPlot(0)->setRange(-1, 0, 64, 10);
+	pDashboard->updateChrome();
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "Rebuilding the dashboard chrome allocated in steady state";
+}
+
+TEST_F(AllocationTest, SteadyStateSharedDataset) {
+	// An overview and a zoomed view of the same bins
+	osg::ref_ptr<osgtools::Dataset> pDataset = new osgtools::Dataset();
+	pDataset->addSeries(_bins, osg::Vec4(0.0, 1.0, 0.0, 1.0));
+	osg::ref_ptr<osgtools::Histogram> pZoomed = new osgtools::Histogram(400, 300);
+	_pHistogram->setDataset(pDataset.get());
+	pZoomed->setDataset(pDataset.get());
+	pDataset->setSeries(0, _bins);
+	pDataset->setSeries(0, _bins);
+
+	// One copy of the bins and one fill of the bars for both views
+	uint64_t start = getAllocationCount();
+	_bins[0]++;
+	pDataset->setSeries(0, _bins);
+	pZoomed->setRange(10, 0, 20, 10);
+	EXPECT_EQ(getAllocationCount() - start, 0u) << "Updating a shared dataset allocated in steady state";
+}
@@ -0,0 +1,42 @@
+/*
+	AllocationTest.h
+	Counts heap allocations of steady state plot updates
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <cstdint>
+#include <vector>
+
+// OSG
+#include <osg/ref_ptr>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "AllocationCount.h"
+#include "boxplot.h"
+#include "dashboard.h"
+#include "dataset.h"
+#include "histogram.h"
+#include "violinplot.h"
+
+class AllocationTest : public ::testing::Test {
+	protected:
+		osg::ref_ptr<osgtools::Histogram> _pHistogram;
+		std::vector<float> _bins;
+		
+public:
+	AllocationTest() {
+		_pHistogram = new osgtools::Histogram(800, 600);
+		for (int i=0; i < 64; i++)
+			_bins.push_back((float)(i % 10 + 1));
+	}
+
+	virtual ~AllocationTest() {}
+};
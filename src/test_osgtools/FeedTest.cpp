@@ -0,0 +1,130 @@
+/*
+	FeedTest.cpp
+	Tests the shared memory feed between a producer and a histogram
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "FeedTest.h"
+
+#include <thread>
+
+#include <osg/NodeVisitor>
+
+#include "histogramfeed.h"
+
+void produceFrames( osgtools_feed_header* pFeed, int numFrames )
+{
+	for (int n=1; n <= numFrames; n++) {
+		float* bins = osgtools_feed_begin(pFeed);
+		uint32_t numBins = 1 + n % pFeed->maxBins;
+		for (uint32_t i=0; i < numBins; i++)
+			bins[i] = (float)n;
+		osgtools_feed_publish(pFeed, numBins);
+	}
+}
+
+TEST_F(FeedTest, OpenChecksFeed) {
+	ASSERT_TRUE(_pProducer != NULL);
+	uint32_t maxBins = 0;
+	EXPECT_TRUE(osgtools_feed_open("/osgtools_test_missing", &maxBins) == NULL);
+
+	osgtools_feed_header* pConsumer = osgtools_feed_open(_name.c_str(), &maxBins);
+	ASSERT_TRUE(pConsumer != NULL);
+	EXPECT_EQ(maxBins, 256u);
+	EXPECT_TRUE(osgtools_feed_take(pConsumer, maxBins) == NULL) << "Took a frame before any was published";
+	osgtools_feed_close(pConsumer, maxBins);
+}
+
+TEST_F(FeedTest, TakesNewestWholeFrames) {
+	ASSERT_TRUE(_pProducer != NULL);
+	uint32_t maxBins = 0;
+	osgtools_feed_header* pConsumer = osgtools_feed_open(_name.c_str(), &maxBins);
+	ASSERT_TRUE(pConsumer != NULL);
+
+	const int numFrames = 200000;
+	std::thread producer(produceFrames, _pProducer, numFrames);
+
+	// Every frame taken is whole and newer than the last
+	uint64_t last = 0;
+	int numTaken = 0, numOld = 0, numTorn = 0;
+	while (last < numFrames) {
+		osgtools_feed_slot* pSlot = osgtools_feed_take(pConsumer, maxBins);
+		if (!pSlot)
+			continue;
+
+		if (pSlot->frame <= last)
+			numOld++;
+		const float* bins = osgtools_feed_get_bins(pSlot);
+		if (pSlot->numBins != 1 + pSlot->frame % 256 || bins[0] != (float)pSlot->frame
+			|| bins[pSlot->numBins - 1] != (float)pSlot->frame)
+			numTorn++;
+		last = pSlot->frame;
+		numTaken++;
+	}
+	producer.join();
+
+	EXPECT_GT(numTaken, 0);
+	EXPECT_EQ(numOld, 0) << "Took a frame older than the last";
+	EXPECT_EQ(numTorn, 0) << "Took a frame still being written";
+	EXPECT_EQ(pConsumer->numFrames, (uint64_t)numFrames);
+	osgtools_feed_close(pConsumer, maxBins);
+}
+
+TEST_F(FeedTest, FeedsHistogramInPlace) {
+	ASSERT_TRUE(_pProducer != NULL);
+	osg::ref_ptr<osgtools::Histogram> pHistogram = new osgtools::Histogram(800, 600);
+	osg::ref_ptr<osgtools::HistogramFeed> pFeed = new osgtools::HistogramFeed();
+	ASSERT_TRUE(pFeed->open(_name));
+	osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR, osg::NodeVisitor::TRAVERSE_NONE);
+
+	// Nothing to show yet
+	(*pFeed)(pHistogram.get(), &nv);
+	EXPECT_EQ(pFeed->getLastFrame(), 0u);
+	EXPECT_EQ(pHistogram->getNumSeries(), 0);
+
+	produceFrames(_pProducer, 3);
+	EXPECT_TRUE(pFeed->hasFrame());
+	(*pFeed)(pHistogram.get(), &nv);
+	EXPECT_EQ(pFeed->getLastFrame(), 3u);
+	EXPECT_EQ(pHistogram->getNumSeries(), 1);
+	EXPECT_FALSE(pFeed->hasFrame());
+
+	// The histogram keeps the frame after the feed closes
+	pFeed->close();
+	EXPECT_FALSE(pFeed->isOpen());
+	EXPECT_EQ(pHistogram->getNumSeries(), 1);
+}
+
+TEST_F(FeedTest, ClampsBinsToOpenedSize) {
+	ASSERT_TRUE(_pProducer != NULL);
+	osg::ref_ptr<osgtools::Histogram> pHistogram = new osgtools::Histogram(800, 600);
+	osg::ref_ptr<osgtools::HistogramFeed> pFeed = new osgtools::HistogramFeed();
+	ASSERT_TRUE(pFeed->open(_name));
+	osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR, osg::NodeVisitor::TRAVERSE_NONE);
+
+	// A producer writing past its slots is bounded by the size as opened
+	uint32_t slot = _pProducer->producerSlot;
+	osgtools_feed_publish(_pProducer, 8);
+	_pProducer->maxBins = 1u << 30;
+	osgtools_feed_get_slot(_pProducer, 256, slot)->numBins = 1u << 30;
+	(*pFeed)(pHistogram.get(), &nv);
+	_pProducer->maxBins = 256;
+	EXPECT_EQ(pFeed->getLastFrame(), 1u);
+	EXPECT_EQ(pHistogram->getNumBins(), 256);
+}
+
+TEST_F(FeedTest, MissingSeriesKeepsFrame) {
+	ASSERT_TRUE(_pProducer != NULL);
+	osg::ref_ptr<osgtools::Histogram> pHistogram = new osgtools::Histogram(800, 600);
+	osg::ref_ptr<osgtools::HistogramFeed> pFeed = new osgtools::HistogramFeed(1);
+	ASSERT_TRUE(pFeed->open(_name));
+	osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR, osg::NodeVisitor::TRAVERSE_NONE);
+
+	// Series 1 does not exist, so the frame is not shown
+	produceFrames(_pProducer, 1);
+	(*pFeed)(pHistogram.get(), &nv);
+	EXPECT_EQ(pFeed->getLastFrame(), 0u);
+	pFeed->close();
+}
@@ -0,0 +1,43 @@
+/*
+	FeedTest.h
+	Tests the shared memory feed between a producer and a histogram
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <string>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "shmfeed.h"
+
+/*!
+ *	Publishes frames the way the acquisition daemon does: every bin of
+ *	frame n holds n, so a torn frame shows as mixed values
+ *	\param	pFeed		The feed to publish to
+ *	\param	numFrames	The frames to publish
+ */
+void produceFrames( osgtools_feed_header* pFeed, int numFrames );
+
+class FeedTest : public ::testing::Test {
+	protected:
+		std::string _name;
+		osgtools_feed_header* _pProducer;
+		
+public:
+	FeedTest() {
+		_name = "/osgtools_test_" + std::to_string(getpid());
+		_pProducer = osgtools_feed_create(_name.c_str(), 256);
+	}
+
+	virtual ~FeedTest() {
+		osgtools_feed_close(_pProducer, 256);
+		osgtools_feed_unlink(_name.c_str());
+	}
+};
@@ -0,0 +1,299 @@
+/*
+	HistogramTest.cpp
+	Tests the bars, series and datasets of histograms
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "HistogramTest.h"
+
+TEST_F(HistogramTest, DatasetViewsShareBars) {
+	osg::ref_ptr<osgtools::Dataset> pDataset = new osgtools::Dataset();
+	pDataset->addSeries(_bins, osg::Vec4(0.0, 1.0, 0.0, 1.0));
+	osg::ref_ptr<TestHistogram> pZoomed = new TestHistogram(400, 300);
+	_pHistogram->setDataset(pDataset.get());
+	pZoomed->setDataset(pDataset.get());
+
+	// Both views draw the one geometry of the dataset
+	ASSERT_TRUE(_pHistogram->isSharingBars());
+	ASSERT_TRUE(pZoomed->isSharingBars());
+	EXPECT_EQ(_pHistogram->_pSharedGeode->getDrawable(0), pDataset->getBars());
+	EXPECT_EQ(pZoomed->_pSharedGeode->getDrawable(0), pDataset->getBars());
+	EXPECT_EQ(pZoomed->getNumSeries(), 1);
+}
+
+TEST_F(HistogramTest, DatasetKeepsViewRanges) {
+	osg::ref_ptr<osgtools::Dataset> pDataset = new osgtools::Dataset();
+	pDataset->addSeries(_bins, osg::Vec4(0.0, 1.0, 0.0, 1.0));
+	osg::ref_ptr<TestHistogram> pZoomed = new TestHistogram(400, 300);
+	_pHistogram->setDataset(pDataset.get());
+	pZoomed->setDataset(pDataset.get());
+	pZoomed->setRange(2, 0, 5, 4);
+
+	// A view is fit once, when it attaches
+	float xmin, ymin, xmax, ymax;
+	_pHistogram->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(xmin, -1);
+	EXPECT_FLOAT_EQ(xmax, 10);
+	EXPECT_FLOAT_EQ(ymax, 10);
+
+	// Changing the data keeps the zoom of every view
+	_bins[0] = 100;
+	pDataset->setSeries(0, _bins);
+	pZoomed->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(xmin, 2);
+	EXPECT_FLOAT_EQ(ymin, 0);
+	EXPECT_FLOAT_EQ(xmax, 5);
+	EXPECT_FLOAT_EQ(ymax, 4);
+	_pHistogram->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(ymax, 10);
+}
+
+TEST_F(HistogramTest, DatasetForwardsSeries) {
+	osg::ref_ptr<osgtools::Dataset> pDataset = new osgtools::Dataset();
+	pDataset->addSeries(_bins, osg::Vec4(0.0, 1.0, 0.0, 1.0));
+	osg::ref_ptr<TestHistogram> pOther = new TestHistogram(400, 300);
+	_pHistogram->setDataset(pDataset.get());
+	pOther->setDataset(pDataset.get());
+
+	// Bins set through a view go to the dataset and show in every view
+	int counts[3] = { 4, 5, 6 };
+	ASSERT_TRUE(_pHistogram->setSeries(0, counts, 3));
+	ASSERT_EQ(pDataset->getBins(0).size(), 3u);
+	EXPECT_FLOAT_EQ(pDataset->getBins(0)[2], 6);
+
+	EXPECT_EQ(_pHistogram->addSeries(_bins, osg::Vec4(1.0, 0.0, 0.0, 1.0)), 1);
+	EXPECT_EQ(pDataset->getNumSeries(), 2);
+	EXPECT_EQ(pDataset->getSeriesColor(1), osg::Vec4(1.0, 0.0, 0.0, 1.0));
+	EXPECT_EQ(pOther->getNumSeries(), 2);
+
+	ASSERT_TRUE(pOther->setHistogram(_bins));
+	EXPECT_EQ(pDataset->getNumSeries(), 1);
+	EXPECT_EQ(_pHistogram->getNumSeries(), 1);
+}
+
+TEST_F(HistogramTest, PickBins) {
+	_pHistogram->setHistogram(_bins);
+	osgtools::PlotPick pick;
+
+	// The bar under the cursor
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(3), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_EQ(pick.series, 0);
+	EXPECT_EQ(pick.index, 3);
+	EXPECT_FLOAT_EQ(pick.value, 4);
+
+	// Above the bar, in its column
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(3), _pHistogram->getYValuePixel(9), pick));
+	EXPECT_EQ(pick.index, 3);
+
+	// The gap between two bars, and outside of the plot area
+	EXPECT_FALSE(_pHistogram->pick(_pHistogram->getXValuePixel(3.5), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_FALSE(_pHistogram->pick(0, 0, pick));
+}
+
+TEST_F(HistogramTest, PickBinEdges) {
+	_pHistogram->setHistogram(_bins);
+	std::vector<float> edges;
+	for (int i=0; i <= _bins.size(); i++)
+		edges.push_back(i * 10.0f);
+	ASSERT_TRUE(_pHistogram->setBinEdges(edges));
+
+	// A bin holds its lower edge, the last edge closes the last bin
+	EXPECT_EQ(_pHistogram->getBin(-0.5), -1);
+	EXPECT_EQ(_pHistogram->getBin(0), 0);
+	EXPECT_EQ(_pHistogram->getBin(10), 1);
+	EXPECT_EQ(_pHistogram->getBin(99.9), 9);
+	EXPECT_EQ(_pHistogram->getBin(100), -1);
+
+	osgtools::PlotPick pick;
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(25), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_EQ(pick.index, 2);
+	EXPECT_FLOAT_EQ(pick.x, 20);
+	EXPECT_FLOAT_EQ(pick.value, 3);
+}
+
+TEST_F(HistogramTest, PickSeries) {
+	std::vector<float> low(_bins.size(), 2.0f);
+	std::vector<float> high(_bins.size(), 8.0f);
+	_pHistogram->addSeries(high, osg::Vec4(1.0, 0.0, 0.0, 1.0));
+	_pHistogram->addSeries(low, osg::Vec4(0.0, 0.0, 1.0, 1.0));
+	osgtools::PlotPick pick;
+
+	// Grouped, each series has its half of the bin
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(4.8), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_EQ(pick.series, 0);
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(5.2), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_EQ(pick.series, 1);
+	EXPECT_EQ(pick.index, 5);
+	EXPECT_FLOAT_EQ(pick.value, 2);
+
+	// Overlaid, the front bar under the cursor, else the one behind it
+	_pHistogram->setSeriesMode(osgtools::Histogram::OVERLAID);
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(5), _pHistogram->getYValuePixel(1), pick));
+	EXPECT_EQ(pick.series, 1);
+	ASSERT_TRUE(_pHistogram->pick(_pHistogram->getXValuePixel(5), _pHistogram->getYValuePixel(5), pick));
+	EXPECT_EQ(pick.series, 0);
+}
+
+TEST_F(HistogramTest, SeriesModeExtents) {
+	std::vector<float> other(_bins.size(), 3.0f);
+	_pHistogram->addSeries(_bins, osg::Vec4(1.0, 0.0, 0.0, 1.0));
+	_pHistogram->addSeries(other, osg::Vec4(0.0, 0.0, 1.0, 1.0));
+	float left, bottom, right, top;
+
+	// Grouped, side by side within the bin
+	_pHistogram->getBarExtent(0, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(left, 0.55);
+	EXPECT_FLOAT_EQ(right, 1.0);
+	EXPECT_FLOAT_EQ(bottom, 0);
+	EXPECT_FLOAT_EQ(top, 2);
+	_pHistogram->getBarExtent(1, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(left, 1.0);
+	EXPECT_FLOAT_EQ(right, 1.45);
+	EXPECT_FLOAT_EQ(top, 3);
+
+	// Stacked, the second series on top of the first
+	_pHistogram->setSeriesMode(osgtools::Histogram::STACKED);
+	_pHistogram->getBarExtent(1, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(left, 0.55);
+	EXPECT_FLOAT_EQ(right, 1.45);
+	EXPECT_FLOAT_EQ(bottom, 2);
+	EXPECT_FLOAT_EQ(top, 5);
+	float xmin, ymin, xmax, ymax;
+	_pHistogram->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(ymax, 13);
+
+	// Overlaid, in front of each other over the whole bin
+	_pHistogram->setSeriesMode(osgtools::Histogram::OVERLAID);
+	_pHistogram->getBarExtent(1, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(left, 0.55);
+	EXPECT_FLOAT_EQ(bottom, 0);
+	EXPECT_FLOAT_EQ(top, 3);
+	_pHistogram->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(ymax, 10);
+}
+
+TEST_F(HistogramTest, ArithmeticBinViews) {
+	float left, bottom, right, top;
+
+	// Read in place; changes show on the next setHistogram
+	int counts[4] = { 5, 7, 2, 9 };
+	ASSERT_TRUE(_pHistogram->setHistogram(counts, 4, false));
+	_pHistogram->getBarExtent(0, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(top, 7);
+	counts[1] = 70000;
+	_pHistogram->setHistogram(counts, 4, false);
+	_pHistogram->getBarExtent(0, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(top, 70000);
+
+	// Copied and converted to float
+	double fractions[3] = { 0.25, 0.5, 1.5 };
+	_pHistogram->setHistogram(fractions, 3);
+	fractions[2] = 0;
+	_pHistogram->getBarExtent(0, 2, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(top, 1.5);
+
+	unsigned char bytes[2] = { 200, 255 };
+	EXPECT_EQ(_pHistogram->addSeries(bytes, 2, osg::Vec4(1.0, 0.0, 0.0, 1.0), false), 1);
+	_pHistogram->getBarExtent(1, 1, left, bottom, right, top);
+	EXPECT_FLOAT_EQ(top, 255);
+}
+
+TEST_F(HistogramTest, ArithmeticSeriesWithoutBins) {
+	// Null or no bins give an empty series, as the vector overloads do
+	EXPECT_EQ(_pHistogram->addSeries((const int*)0, 4, osg::Vec4(1.0, 0.0, 0.0, 1.0)), 0);
+	EXPECT_EQ(_pHistogram->addSeries((const double*)0, 0, osg::Vec4(0.0, 1.0, 0.0, 1.0), false), 1);
+	EXPECT_EQ(_pHistogram->getNumSeries(), 2);
+	EXPECT_EQ(_pHistogram->getNumBins(), 0);
+
+	// Setting no bins clears the series
+	short counts[3] = { 1, 2, 3 };
+	ASSERT_TRUE(_pHistogram->setSeries(0, counts, 3));
+	EXPECT_EQ(_pHistogram->getNumBins(), 3);
+	EXPECT_TRUE(_pHistogram->setSeries(0, counts, -1));
+	EXPECT_EQ(_pHistogram->getNumBins(), 0);
+	EXPECT_TRUE(_pHistogram->setSeries(0, (const short*)0, 3, false));
+	EXPECT_EQ(_pHistogram->getNumBins(), 0);
+	EXPECT_FALSE(_pHistogram->setSeries(2, counts, 3));
+}
+
+TEST_F(HistogramTest, DensityBlur) {
+	// A bandwidth of one bin is a single box of three bins
+	std::vector<float> impulse(11, 0.0f);
+	impulse[5] = 9;
+	_pHistogram->setHistogram(impulse);
+	_pHistogram->setDensityOverlay(0, 1.0);
+	ASSERT_EQ(_pHistogram->_density.size(), impulse.size());
+	for (int i=0; i < impulse.size(); i++)
+		EXPECT_FLOAT_EQ(_pHistogram->_density[i], (i >= 4 && i <= 6 ? 3 : 0)) << "Bin " << i;
+
+	// Wider kernels keep the mass and the symmetry
+	_pHistogram->setDensityOverlay(0, 2.0);
+	float sum = 0;
+	for (int i=0; i < impulse.size(); i++)
+		sum += _pHistogram->_density[i];
+	EXPECT_NEAR(sum, 9, 1e-4);
+	EXPECT_FLOAT_EQ(_pHistogram->_density[3], _pHistogram->_density[7]);
+	EXPECT_LT(_pHistogram->_density[5], 3);
+
+	// No bandwidth leaves the bins as they are
+	_pHistogram->setDensityOverlay(0, 0.0);
+	EXPECT_FLOAT_EQ(_pHistogram->_density[5], 9);
+	EXPECT_FLOAT_EQ(_pHistogram->_density[4], 0);
+}
+
+TEST_F(HistogramTest, BoxBlurMatchesWindowAverage) {
+	// Values past the ends count as zero
+	std::vector<float> blurred(_bins.size());
+	int radius = 2;
+	TestHistogram::boxBlur(&_bins[0], &blurred[0], _bins.size(), radius);
+	for (int i=0; i < _bins.size(); i++) {
+		float sum = 0;
+		for (int j=i - radius; j <= i + radius; j++) {
+			if (j >= 0 && j < _bins.size())
+				sum += _bins[j];
+		}
+		EXPECT_NEAR(blurred[i], sum / (2 * radius + 1), 1e-5) << "Bin " << i;
+	}
+}
+
+TEST_F(HistogramTest, TransitionStartsFromShownBars) {
+	_pHistogram->setTransitionDuration(1.0);
+	_pHistogram->setHistogram(_bins);
+
+	// Finish the first transition, then change the bins
+	_pHistogram->_pTransition->set(1.0f);
+	std::vector<float> halved(_bins);
+	for (int i=0; i < halved.size(); i++)
+		halved[i] /= 2;
+	_pHistogram->setHistogram(halved);
+	ASSERT_TRUE(_pHistogram->getPreviousVertices() != 0);
+	std::vector<osg::Vec3> shown(_pHistogram->getPreviousVertices()->begin(), _pHistogram->getPreviousVertices()->end());
+	std::vector<osg::Vec3> target(_pHistogram->getVertices()->begin(), _pHistogram->getVertices()->end());
+	float t;
+	_pHistogram->_pTransition->get(t);
+	EXPECT_FLOAT_EQ(t, 0);
+
+	// Changed again half way, the next transition starts in between
+	_pHistogram->_pTransition->set(0.5f);
+	std::vector<float> more(_bins);
+	more.push_back(4);
+	_pHistogram->setHistogram(more);
+	osg::Vec3Array* previous = _pHistogram->getPreviousVertices();
+	osg::Vec3Array* vertices = _pHistogram->getVertices();
+	ASSERT_EQ(previous->size(), vertices->size());
+	ASSERT_EQ(shown.size(), target.size());
+	ASSERT_LT(shown.size(), vertices->size());
+	for (int i=0; i < shown.size(); i++) {
+		osg::Vec3 expected = shown[i] + (target[i] - shown[i]) * 0.5;
+		EXPECT_NEAR((*previous)[i].x(), expected.x(), 1e-3) << "Vertex " << i;
+		EXPECT_NEAR((*previous)[i].y(), expected.y(), 1e-3) << "Vertex " << i;
+	}
+
+	// The new bar grows from its base
+	for (int i=shown.size(); i < vertices->size(); i++) {
+		EXPECT_FLOAT_EQ((*previous)[i].x(), (*vertices)[i].x());
+		EXPECT_FLOAT_EQ((*previous)[i].y(), (*vertices)[i - i % 4].y());
+	}
+}
@@ -0,0 +1,60 @@
+/*
+	HistogramTest.h
+	Tests the bars, series and datasets of histograms
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <vector>
+
+// OSG
+#include <osg/ref_ptr>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "dataset.h"
+#include "histogram.h"
+#include "shaders.h"
+
+/*!
+ *	Opens the internals of a histogram to the tests
+ */
+class TestHistogram : public osgtools::Histogram {
+public:
+	TestHistogram( int width, int height ) : osgtools::Histogram(width, height) {}
+
+	using osgtools::Histogram::getBarExtent;
+	using osgtools::Histogram::getBin;
+	using osgtools::Histogram::isSharingBars;
+	using osgtools::Histogram::boxBlur;
+	using osgtools::Histogram::_density;
+	using osgtools::Histogram::_pBars;
+	using osgtools::Histogram::_pTransition;
+
+	osg::Vec3Array* getVertices() { return static_cast<osg::Vec3Array*>( _pBars->getVertexArray() ); }
+	osg::Vec3Array* getPreviousVertices() {
+		return static_cast<osg::Vec3Array*>( _pBars->getVertexAttribArray(osgtools::Shaders::PREVIOUS_VERTEX_LOCATION) );
+	}
+	using osgtools::Histogram::_pSharedGeode;
+};
+
+class HistogramTest : public ::testing::Test {
+	protected:
+		osg::ref_ptr<TestHistogram> _pHistogram;
+		std::vector<float> _bins;
+		
+public:
+	HistogramTest() {
+		_pHistogram = new TestHistogram(800, 600);
+		for (int i=0; i < 10; i++)
+			_bins.push_back((float)(i + 1));
+	}
+
+	virtual ~HistogramTest() {}
+};
@@ -0,0 +1,109 @@
+/*
+	PlotTest.cpp
+	Tests the tiles of dashboards and the summaries of distribution plots
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "PlotTest.h"
+
+TEST_F(PlotTest, DashboardTiles) {
+	osg::ref_ptr<osgtools::Plot> plots[4];
+	for (int i=0; i < 4; i++) {
+		plots[i] = new osgtools::Histogram(400, 300);
+		ASSERT_TRUE(_pDashboard->addPlot(plots[i].get()));
+	}
+	EXPECT_FALSE(_pDashboard->addPlot(plots[0].get()));
+	EXPECT_TRUE(plots[0]->isTile());
+
+	// Rows fill from the top left
+	int x, y, width, height;
+	ASSERT_TRUE(_pDashboard->getTile(1, x, y, width, height));
+	EXPECT_EQ(x, 500);
+	EXPECT_EQ(y, 600);
+	EXPECT_EQ(width, 500);
+	EXPECT_EQ(height, 600);
+	ASSERT_TRUE(_pDashboard->getTile(3, x, y, width, height));
+	EXPECT_EQ(x, 0);
+	EXPECT_EQ(y, 0);
+	EXPECT_FALSE(_pDashboard->getTile(4, x, y, width, height));
+
+	// Window pixels map into the tile under them
+	float plotX, plotY;
+	EXPECT_EQ(_pDashboard->getPlotAt(510, 700, plotX, plotY), plots[1].get());
+	EXPECT_FLOAT_EQ(plotX, 10);
+	EXPECT_FLOAT_EQ(plotY, 100);
+	EXPECT_EQ(_pDashboard->getPlotAt(20, 30, plotX, plotY), plots[3].get());
+	EXPECT_TRUE(_pDashboard->getPlotAt(1200, 100, plotX, plotY) == 0) << "No tile in the last cell";
+
+	// Removing a plot moves the others up
+	ASSERT_TRUE(_pDashboard->removePlot(plots[0].get()));
+	EXPECT_FALSE(plots[0]->isTile());
+	EXPECT_EQ(_pDashboard->getPlotAt(20, 700, plotX, plotY), plots[1].get());
+	EXPECT_EQ(_pDashboard->getNumPlots(), 3u);
+	ASSERT_TRUE(_pDashboard->getTile(0, x, y, width, height));
+	EXPECT_EQ(height, 1200);
+}
+
+TEST_F(PlotTest, BoxPlotRangeAndPick) {
+	osg::ref_ptr<osgtools::BoxPlot> pPlot = new osgtools::BoxPlot(800, 600);
+	std::vector<osgtools::BoxSummary> boxes;
+	EXPECT_FALSE(pPlot->setBoxes(boxes));
+	boxes.push_back(osgtools::BoxSummary(0, 2, 5, 8, 10));
+	boxes.push_back(osgtools::BoxSummary(-5, 0, 3, 12, 20));
+	ASSERT_TRUE(pPlot->setBoxes(boxes));
+
+	// One box per x unit, the whiskers padded by 5%
+	float xmin, ymin, xmax, ymax;
+	pPlot->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(xmin, -1);
+	EXPECT_FLOAT_EQ(xmax, 2);
+	EXPECT_FLOAT_EQ(ymin, -6.25);
+	EXPECT_FLOAT_EQ(ymax, 21.25);
+
+	// Picks the box in the column, giving its median
+	osgtools::PlotPick pick;
+	ASSERT_TRUE(pPlot->pick(pPlot->getXValuePixel(1.2), pPlot->getYValuePixel(15), pick));
+	EXPECT_EQ(pick.index, 1);
+	EXPECT_FLOAT_EQ(pick.value, 3);
+	EXPECT_FALSE(pPlot->pick(pPlot->getXValuePixel(0.5), pPlot->getYValuePixel(5), pick));
+
+	// Replacing a box refits the range
+	EXPECT_FALSE(pPlot->setBox(2, boxes[0]));
+	ASSERT_TRUE(pPlot->setBox(1, osgtools::BoxSummary(0, 1, 2, 3, 4)));
+	pPlot->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(ymin, -0.5);
+	EXPECT_FLOAT_EQ(ymax, 10.5);
+	ASSERT_TRUE(pPlot->pick(pPlot->getXValuePixel(1), pPlot->getYValuePixel(5), pick));
+	EXPECT_FLOAT_EQ(pick.value, 2);
+}
+
+TEST_F(PlotTest, ViolinPlotRangeAndPick) {
+	osg::ref_ptr<osgtools::ViolinPlot> pPlot = new osgtools::ViolinPlot(800, 600);
+	std::vector<osgtools::ViolinSummary> violins(3);
+	for (int i=0; i < 3; i++) {
+		violins[i].min = i;
+		violins[i].max = 10 + i;
+		violins[i].median = 5 + i;
+		violins[i].density.assign(5, 1.0f);
+	}
+	violins[2].density.resize(1);
+	EXPECT_FALSE(pPlot->setViolins(violins)) << "A violin needs two samples";
+	violins[2].density.resize(2);
+	ASSERT_TRUE(pPlot->setViolins(violins));
+
+	float xmin, ymin, xmax, ymax;
+	pPlot->getRange(xmin, ymin, xmax, ymax);
+	EXPECT_FLOAT_EQ(xmin, -1);
+	EXPECT_FLOAT_EQ(xmax, 3);
+	EXPECT_FLOAT_EQ(ymin, -0.6);
+	EXPECT_FLOAT_EQ(ymax, 12.6);
+
+	osgtools::PlotPick pick;
+	ASSERT_TRUE(pPlot->pick(pPlot->getXValuePixel(2), pPlot->getYValuePixel(3), pick));
+	EXPECT_EQ(pick.index, 2);
+	EXPECT_FLOAT_EQ(pick.value, 7);
+	EXPECT_FALSE(pPlot->pick(pPlot->getXValuePixel(1.5), pPlot->getYValuePixel(3), pick));
+	EXPECT_FALSE(pPlot->setViolin(0, osgtools::ViolinSummary()));
+}
@@ -0,0 +1,33 @@
+/*
+	PlotTest.h
+	Tests the tiles of dashboards and the summaries of distribution plots
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// OSG
+#include <osg/ref_ptr>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "boxplot.h"
+#include "dashboard.h"
+#include "histogram.h"
+#include "violinplot.h"
+
+class PlotTest : public ::testing::Test {
+	protected:
+		osg::ref_ptr<osgtools::Dashboard> _pDashboard;
+		
+public:
+	PlotTest() {
+		_pDashboard = new osgtools::Dashboard(1500, 1200, 3);
+	}
+
+	virtual ~PlotTest() {}
+};
@@ -0,0 +1,96 @@
+/*
+	QuantileSketchTest.cpp
+	Tests the streaming quantile sketch
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "QuantileSketchTest.h"
+
+TEST_F(QuantileSketchTest, QuantilesWithinRelativeError) {
+	osgtools::QuantileSketch sketch(0.01);
+	for (int i=0; i < _values.size(); i++)
+		sketch.add(_values[i]);
+	EXPECT_EQ(sketch.getCount(), (double)_values.size());
+
+	std::vector<double> sorted(_values);
+	std::sort(sorted.begin(), sorted.end());
+	EXPECT_EQ(sketch.getMin(), sorted.front());
+	EXPECT_EQ(sketch.getMax(), sorted.back());
+
+	const double q[] = { 0.0, 0.001, 0.01, 0.25, 0.5, 0.9, 0.99, 0.999, 1.0 };
+	for (int i=0; i < sizeof(q) / sizeof(q[0]); i++) {
+		double exact = sorted[(int)(q[i] * (sorted.size() - 1))];
+		EXPECT_LE(std::fabs(sketch.getQuantile(q[i]) - exact), 0.01 * std::fabs(exact) + 1e-12) << "q = " << q[i];
+	}
+}
+
+TEST_F(QuantileSketchTest, MergeMatchesSingleSketch) {
+	// One sketch per producer thread, merged by the viewer
+	osgtools::QuantileSketch single, parts[4], merged;
+	for (int i=0; i < _values.size(); i++) {
+		single.add(_values[i]);
+		parts[i % 4].add(_values[i]);
+	}
+	for (int i=0; i < 4; i++)
+		ASSERT_TRUE(merged.merge(parts[i]));
+
+	EXPECT_EQ(merged.getCount(), single.getCount());
+	EXPECT_EQ(merged.getNumBuckets(), single.getNumBuckets());
+	EXPECT_EQ(merged.getMin(), single.getMin());
+	EXPECT_EQ(merged.getMax(), single.getMax());
+	for (double q=0; q <= 1.0; q += 0.05)
+		EXPECT_EQ(merged.getQuantile(q), single.getQuantile(q));
+
+	// Different accuracies do not merge
+	osgtools::QuantileSketch coarse(0.05);
+	EXPECT_FALSE(merged.merge(coarse));
+}
+
+TEST_F(QuantileSketchTest, BoundedBuckets) {
+	osgtools::QuantileSketch sketch(0.01, 100);
+	for (int i=0; i < _values.size(); i++)
+		sketch.add(_values[i]);
+	EXPECT_LE(sketch.getNumBuckets(), 200);
+
+	// The tail keeps its accuracy
+	std::vector<double> sorted(_values);
+	std::sort(sorted.begin(), sorted.end());
+	double exact = sorted[(int)(0.999 * (sorted.size() - 1))];
+	EXPECT_LE(std::fabs(sketch.getQuantile(0.999) - exact), 0.01 * exact);
+}
+
+TEST_F(QuantileSketchTest, RebinsIntoRange) {
+	osgtools::QuantileSketch sketch;
+	for (int i=0; i < _values.size(); i++)
+		sketch.add(_values[i]);
+
+	// Bins covering every value count all of them
+	std::vector<float> edges, bins;
+	for (int i=0; i <= 10; i++)
+		edges.push_back((float)(sketch.getMin() + (sketch.getMax() - sketch.getMin()) * i / 10));
+	edges.back() = (float)sketch.getMax() * 1.01f;
+	sketch.getBins(edges, bins);
+	ASSERT_EQ(bins.size(), 10u);
+	double total = 0;
+	for (int i=0; i < bins.size(); i++)
+		total += bins[i];
+	EXPECT_NEAR(total, sketch.getCount(), 1e-3 * sketch.getCount());
+
+	// A narrow range counts only its values, within the accuracy
+	edges.clear();
+	edges.push_back(1e-2f);
+	edges.push_back(1e-1f);
+	edges.push_back(1.0f);
+	sketch.getBins(edges, bins);
+	ASSERT_EQ(bins.size(), 2u);
+	for (int i=0; i < 2; i++) {
+		int exact = 0;
+		for (int j=0; j < _values.size(); j++) {
+			if (_values[j] >= edges[i] && _values[j] < edges[i + 1])
+				exact++;
+		}
+		EXPECT_NEAR(bins[i], exact, 0.02 * exact);
+	}
+}
@@ -0,0 +1,38 @@
+/*
+	QuantileSketchTest.h
+	Tests the streaming quantile sketch
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "quantilesketch.h"
+
+class QuantileSketchTest : public ::testing::Test {
+	protected:
+		std::vector<double> _values;
+		
+public:
+	QuantileSketchTest() {
+		// Latencies spanning six decades, with a few negative values
+		srand(1);
+		for (int i=0; i < 20000; i++)
+			_values.push_back(1e-3 * std::pow(10.0, 6.0 * rand() / RAND_MAX));
+		for (int i=0; i < 100; i++)
+			_values.push_back(-(double)(i + 1));
+	}
+
+	virtual ~QuantileSketchTest() {}
+};
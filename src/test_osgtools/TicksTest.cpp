@@ -0,0 +1,135 @@
+/*
+	TicksTest.cpp
+	Tests the tick placement and scales of plot axes
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#include "TicksTest.h"
+
+#include <cmath>
+
+TEST_F(TicksTest, NiceSteps) {
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getNiceStep(10.0, 10), 1.0);
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getNiceStep(7.0, 6), 2.0);
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getNiceStep(0.3, 6), 0.05);
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getNiceStep(123456.0, 6), 50000.0);
+	EXPECT_EQ(osgtools::Ticks::getNiceStep(0.0, 6), 0.0) << "Empty range has no step";
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getMinorStep(5.0), 1.0);
+	EXPECT_DOUBLE_EQ(osgtools::Ticks::getMinorStep(0.2), 0.1);
+}
+
+TEST_F(TicksTest, Multiples) {
+	// Ticks in [-1, 10), excluding the end
+	ASSERT_TRUE(osgtools::Ticks::getTicks(-1.0, 10.0, 2.0, 100, _span));
+	ASSERT_EQ(_span.count, 5);
+	EXPECT_EQ(_span.getValue(0), 0.0);
+	EXPECT_EQ(_span.getValue(4), 8.0);
+
+	// Decimal steps land on exact multiples
+	ASSERT_TRUE(osgtools::Ticks::getTicks(0.3, 1.0, 0.1, 100, _span));
+	ASSERT_EQ(_span.count, 7);
+	EXPECT_DOUBLE_EQ(_span.getValue(0), 0.3);
+	EXPECT_DOUBLE_EQ(_span.getValue(6), 0.9);
+}
+
+TEST_F(TicksTest, BoundedCount) {
+	// A step far below the range is coarsened instead of looping
+	ASSERT_TRUE(osgtools::Ticks::getTicks(-1e30, 1e30, 1e-30, 50, _span));
+	EXPECT_LE(_span.count, 50);
+	EXPECT_GT(_span.step, 1e28);
+
+	// A step far below the magnitude of the values
+	ASSERT_TRUE(osgtools::Ticks::getTicks(1e9, 1e9 + 1.0, 1e-6, 10, _span));
+	EXPECT_LE(_span.count, 10);
+	EXPECT_GT(_span.getValue(1), _span.getValue(0));
+}
+
+TEST_F(TicksTest, BadInput) {
+	EXPECT_FALSE(osgtools::Ticks::getTicks(0.0, 10.0, 0.0, 10, _span));
+	EXPECT_FALSE(osgtools::Ticks::getTicks(10.0, 0.0, 1.0, 10, _span));
+	EXPECT_EQ(_span.count, 0);
+}
+
+TEST_F(TicksTest, LogScale) {
+	osg::ref_ptr<osgtools::LogScale> pScale = new osgtools::LogScale();
+	std::vector<double> values;
+
+	// Major ticks on the decades
+	pScale->getTicks(1.0, 1e6, 1.0, 100, values);
+	ASSERT_EQ(values.size(), 6u);
+	EXPECT_DOUBLE_EQ(values[0], 1.0);
+	EXPECT_DOUBLE_EQ(values[5], 1e5);
+
+	// Minor ticks at 1 to 9 times the decades
+	pScale->getTicks(1.0, 100.0, 0.5, 100, values, true);
+	ASSERT_EQ(values.size(), 18u);
+	EXPECT_DOUBLE_EQ(values[1], 2.0);
+	EXPECT_DOUBLE_EQ(values[9], 10.0);
+
+	// Major ticks at half decades, not rounded
+	pScale->getTicks(1.0, 100.0, 0.5, 100, values);
+	ASSERT_EQ(values.size(), 4u);
+	EXPECT_DOUBLE_EQ(values[1], sqrt(10.0));
+	EXPECT_DOUBLE_EQ(values[2], 10.0);
+
+	// A step of 0 is no grid, major or minor
+	pScale->getTicks(1.0, 100.0, 0.0, 100, values);
+	EXPECT_TRUE(values.empty());
+	pScale->getTicks(1.0, 100.0, 0.0, 100, values, true);
+	EXPECT_TRUE(values.empty());
+
+	// Bins of equal width in decades
+	std::vector<float> edges;
+	pScale->getBinEdges(1.0, 1000.0, 3, edges);
+	ASSERT_EQ(edges.size(), 4u);
+	EXPECT_FLOAT_EQ(edges[1], 10.0);
+	EXPECT_EQ(pScale->getBin(50.0, 1.0, 1000.0, 3), 1);
+	EXPECT_EQ(pScale->getBin(5000.0, 1.0, 1000.0, 3), -1);
+}
+
+TEST_F(TicksTest, SymlogScale) {
+	osg::ref_ptr<osgtools::SymlogScale> pScale = new osgtools::SymlogScale(1.0);
+	EXPECT_DOUBLE_EQ(pScale->forward(0.5), 0.5);
+	EXPECT_DOUBLE_EQ(pScale->forward(-100.0), -3.0);
+	EXPECT_DOUBLE_EQ(pScale->inverse(pScale->forward(-42.0)), -42.0);
+
+	// Whole steps land on zero and the powers of ten
+	std::vector<double> values;
+	pScale->getTicks(-1000.0, 1000.0, 1.0, 100, values);
+	ASSERT_EQ(values.size(), 8u);
+	EXPECT_DOUBLE_EQ(values[0], -1000.0);
+	EXPECT_DOUBLE_EQ(values[4], 0.0);
+	EXPECT_DOUBLE_EQ(values[7], 100.0);
+}
+
+TEST_F(TicksTest, DenseLabelsCulled) {
+	// A narrow plot zoomed far out of its bins, with a grid line at
+	// every bin across the range
+	osg::ref_ptr<osgtools::Histogram> pHistogram = new osgtools::Histogram(200, 200);
+	std::vector<float> bins(10, 1.0f);
+	pHistogram->setHistogram(bins);
+	pHistogram->setRange(0, 0, 10000, 10000);
+
+	osgtools::PlotLayout layout;
+	pHistogram->computeLayout(layout);
+	int x, y, width, height;
+	pHistogram->getPlotDimensions(x, y, width, height);
+
+	// The labels left fit the axes without overlapping
+	const std::vector<osgtools::PlotLabel>& xLabels = layout.tickLabels[0];
+	ASSERT_FALSE(xLabels.empty());
+	EXPECT_LT(xLabels.size(), layout.majorTicks[0].size());
+	for (int i=1; i < xLabels.size(); i++) {
+		EXPECT_GT(xLabels[i - 1].width, 0.0f);
+		EXPECT_LE(xLabels[i - 1].position.x() + xLabels[i - 1].width, xLabels[i].position.x());
+	}
+	EXPECT_LE(xLabels.size() * xLabels[0].size / 2, width);
+
+	const std::vector<osgtools::PlotLabel>& yLabels = layout.tickLabels[1];
+	ASSERT_FALSE(yLabels.empty());
+	for (int i=1; i < yLabels.size(); i++)
+		EXPECT_LE(yLabels[i - 1].position.y() + yLabels[i - 1].size, yLabels[i].position.y());
+	EXPECT_LE(yLabels.size() * yLabels[0].size, height);
+}
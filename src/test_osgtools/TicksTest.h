@@ -0,0 +1,30 @@
+/*
+	TicksTest.h
+	Tests the tick placement and scales of plot axes
+	
+	Tim Garrett (garrettt@iastate.edu)
+	2026.10.19
+*/
+
+#pragma once
+
+// OSG
+#include <osg/ref_ptr>
+
+// GTest
+#include <gtest/gtest.h>
+
+// Local
+#include "axisscale.h"
+#include "histogram.h"
+#include "ticks.h"
+
+class TicksTest : public ::testing::Test {
+	protected:
+		osgtools::TickSpan _span;
+		
+public:
+	TicksTest() {}
+
+	virtual ~TicksTest() {}
+};